@@ -53,6 +53,20 @@ static std::string SqlReturnCodeToString(SQLRETURN return_code) {
   }
 }
 
+// True when a call failed because the driver doesn't support the function, information type or attribute
+// value, rather than e.g. because the connection was lost
+static bool IsNotSupported(SQLSMALLINT handle_type, SQLHANDLE handle) {
+  auto state = ExtractDiagnostics(handle_type, handle)->state;
+  return state == "HYC00" || state == "IM001" || state == "HY092" || state == "HY096" || state == "HY024";
+}
+
+// True when a call failed because the connection to the data source failed or timed out, rather than because
+// the data source rejected the statement
+static bool IsConnectionFailure(SQLSMALLINT handle_type, SQLHANDLE handle) {
+  auto state = ExtractDiagnostics(handle_type, handle)->state;
+  return state.rfind("08", 0) == 0 || state == "HYT00" || state == "HYT01";
+}
+
 static void ThrowExceptionWithDiagnostics(std::string msg_prefix, SQLSMALLINT handle_type, SQLHANDLE handle,
                                           SQLRETURN return_code) {
   auto diagnostics = ExtractDiagnostics(handle_type, handle);
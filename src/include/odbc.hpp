@@ -9,6 +9,24 @@
 #include "sqlext.h"
 
 namespace duckdb {
+// sql data types of IBM DB2 drivers that unixODBC doesn't define
+#ifndef SQL_GRAPHIC
+#define SQL_GRAPHIC -95
+#endif
+#ifndef SQL_VARGRAPHIC
+#define SQL_VARGRAPHIC -96
+#endif
+#ifndef SQL_LONGVARGRAPHIC
+#define SQL_LONGVARGRAPHIC -97
+#endif
+#ifndef SQL_DECFLOAT
+#define SQL_DECFLOAT -360
+#endif
+
+// characters of a DECFLOAT value's text besides its digits: sign, decimal point, exponent marker, exponent
+// sign, up to 4 exponent digits and the null terminator
+#define ODBC_DECFLOAT_TEXT_OVERHEAD 9
+
 struct OdbcEnvironment {
   OdbcEnvironment() { handle = SQL_NULL_HENV; }
   ~OdbcEnvironment() { FreeHandle(); }
@@ -50,6 +68,24 @@ public:
 
 #define MAX_CONN_STR_OUT 1024
 
+// A statement or connection attribute passed through to the driver
+struct OdbcAttribute {
+  SQLINTEGER attribute;
+  // string valued attributes are passed with SQL_NTS. Other attributes are passed as an integer
+  bool is_string;
+  SQLULEN integer_value;
+  string string_value;
+
+  SQLPOINTER Pointer() const {
+    return is_string ? (SQLPOINTER)string_value.c_str() : (SQLPOINTER)integer_value;
+  }
+  SQLINTEGER StringLength() const { return is_string ? SQL_NTS : 0; }
+  // Identifies the attribute and its value in cache keys
+  string ToString() const {
+    return std::to_string(attribute) + "=" + (is_string ? string_value : std::to_string(integer_value));
+  }
+};
+
 struct OdbcConnection {
   OdbcConnection() : handle(SQL_NULL_HDBC), dialed(false) {}
   ~OdbcConnection() {
@@ -71,7 +107,7 @@ struct OdbcConnection {
   }
 
 public:
-  void Init(shared_ptr<OdbcEnvironment> &env) {
+  void Init(const shared_ptr<OdbcEnvironment> &env) {
     if (handle != SQL_NULL_HDBC) {
       throw Exception("OdbcConnection->Init(): connection handle is not null");
     }
@@ -110,11 +146,53 @@ public:
 
     dialed = false;
   }
+  void SetAttribute(const OdbcAttribute &attribute) {
+    auto return_code =
+        SQLSetConnectAttr(handle, attribute.attribute, attribute.Pointer(), attribute.StringLength());
+    if (!SQL_SUCCEEDED(return_code)) {
+      ThrowExceptionWithDiagnostics("OdbcConnection->SetAttribute() SQLSetConnectAttr", SQL_HANDLE_DBC,
+                                    handle, return_code);
+    }
+  }
+  // Reads a string valued SQLGetInfo property of the driver or data source. Returns false when the driver
+  // doesn't support the information type
+  bool TryGetInfoString(SQLUSMALLINT info_type, string &value) {
+    SQLCHAR buffer[256] = {0};
+    SQLSMALLINT string_length = 0;
+
+    auto return_code = SQLGetInfo(handle, info_type, buffer, sizeof(buffer), &string_length);
+    if (!SQL_SUCCEEDED(return_code)) {
+      if (IsNotSupported(SQL_HANDLE_DBC, handle)) {
+        return false;
+      }
+      ThrowExceptionWithDiagnostics("OdbcConnection->TryGetInfoString() SQLGetInfo", SQL_HANDLE_DBC, handle,
+                                    return_code);
+    }
+
+    value = string((char *)buffer);
+    return true;
+  }
+  // Reads whether the driver supports an ODBC function. Returns false when the driver can't report it
+  bool TrySupportsFunction(SQLUSMALLINT function_id, bool &supports_function) {
+    SQLUSMALLINT supported = SQL_FALSE;
+
+    auto return_code = SQLGetFunctions(handle, function_id, &supported);
+    if (!SQL_SUCCEEDED(return_code)) {
+      if (IsNotSupported(SQL_HANDLE_DBC, handle)) {
+        return false;
+      }
+      ThrowExceptionWithDiagnostics("OdbcConnection->TrySupportsFunction() SQLGetFunctions", SQL_HANDLE_DBC,
+                                    handle, return_code);
+    }
+
+    supports_function = supported == SQL_TRUE;
+    return true;
+  }
   SQLHSTMT Handle() { return handle; }
 };
 
 struct OdbcColumnDescription {
-  SQLCHAR name[32];
+  SQLCHAR name[256];
   SQLSMALLINT name_length;
   SQLSMALLINT sql_data_type;
   SQLSMALLINT c_data_type;
@@ -125,14 +203,30 @@ struct OdbcColumnDescription {
 };
 
 struct OdbcStatementOptions {
-  OdbcStatementOptions(SQLULEN _row_array_size) : row_array_size(_row_array_size) {}
+  OdbcStatementOptions(SQLULEN _row_array_size, bool _fetch_scroll = true)
+      : row_array_size(_row_array_size), fetch_scroll(_fetch_scroll), max_rows(0) {}
 
   SQLULEN row_array_size;
+  // rowsets are fetched with SQLFetch when the driver doesn't implement SQLFetchScroll
+  bool fetch_scroll;
+  // SQL_ATTR_MAX_ROWS. 0 returns every row
+  SQLULEN max_rows;
+  // set after the streaming defaults so they can be overridden
+  vector<OdbcAttribute> attributes;
+
+  // Identifies the attributes in cache keys
+  string AttributesToString() const {
+    string result;
+    for (auto &attribute : attributes) {
+      result += attribute.ToString() + ";";
+    }
+    return result;
+  }
 };
 
 struct OdbcStatement {
   OdbcStatement(shared_ptr<OdbcConnection> _conn)
-      : conn(_conn), handle(SQL_NULL_HSTMT), prepared(false), executing(false) {}
+      : conn(_conn), handle(SQL_NULL_HSTMT), prepared(false), executing(false), fetch_scroll(true) {}
   ~OdbcStatement() {
     prepared = false;
     executing = false;
@@ -143,6 +237,11 @@ struct OdbcStatement {
   SQLHSTMT handle;
   bool prepared;
   bool executing;
+  bool fetch_scroll;
+  // SQL the statement was last prepared with
+  std::string sql_statement;
+  // attributes the statement was configured with before it was prepared
+  std::string attributes;
 
   void FreeHandle() {
     if (handle != SQL_NULL_HSTMT) {
@@ -167,13 +266,35 @@ public:
                                     return_code);
     }
   }
+  // Sets the attributes drivers only accept before a statement is prepared. A forward only, read only cursor
+  // lets drivers stream rows instead of materializing the result set. Attributes of opts are set after the
+  // streaming defaults so they can override them
+  void Configure(const OdbcStatementOptions &opts) {
+    if (handle == SQL_NULL_HSTMT) {
+      throw Exception("OdbcStatement->Configure() handle has not been allocated. Call "
+                      "OdbcStatement#Init() before OdbcStatement#Configure()");
+    }
+    if (prepared) {
+      throw Exception("OdbcStatement->Configure() statement is prepared");
+    }
+
+    TrySetAttribute(SQL_ATTR_CURSOR_TYPE, (SQLPOINTER)SQL_CURSOR_FORWARD_ONLY);
+    TrySetAttribute(SQL_ATTR_CONCURRENCY, (SQLPOINTER)SQL_CONCUR_READ_ONLY);
+    for (auto &attribute : opts.attributes) {
+      SetAttribute(attribute.attribute, attribute.Pointer(), attribute.StringLength());
+    }
+
+    attributes = opts.AttributesToString();
+  }
   void Prepare(std::string sql_statement) {
     if (handle == SQL_NULL_HSTMT) {
       throw Exception("OdbcStatement->Prepare() handle has not been allocated. Call "
                       "OdbcStatement#Init() before OdbcStatement#Prepare()");
     }
 
-    auto sql_len = (SQLSMALLINT)sql_statement.length();
+    // SQLPrepare takes an SQLINTEGER length. Rewritten statements, e.g. with join filter IN lists, can be
+    // longer than an SQLSMALLINT holds
+    auto sql_len = (SQLINTEGER)sql_statement.length();
     auto return_code = SQLPrepare(handle, (SQLCHAR *)sql_statement.c_str(), sql_len);
     if (return_code != SQL_SUCCESS && return_code != SQL_SUCCESS_WITH_INFO) {
       ThrowExceptionWithDiagnostics("OdbcStatement->Prepare() SQLPrepare", SQL_HANDLE_STMT, handle,
@@ -181,19 +302,78 @@ public:
     }
 
     prepared = true;
+    this->sql_statement = sql_statement;
+  }
+  // Prepares a statement the data source may reject, e.g. one rewritten with a clause it doesn't support.
+  // Returns false when the data source rejects it or its result doesn't have expected_columns columns, in
+  // which case another statement has to be prepared. Connection failures and timeouts are raised
+  bool TryPrepare(std::string sql_statement, SQLSMALLINT expected_columns) {
+    if (handle == SQL_NULL_HSTMT) {
+      throw Exception("OdbcStatement->TryPrepare() handle has not been allocated. Call "
+                      "OdbcStatement#Init() before OdbcStatement#TryPrepare()");
+    }
+
+    auto sql_len = (SQLINTEGER)sql_statement.length();
+    auto return_code = SQLPrepare(handle, (SQLCHAR *)sql_statement.c_str(), sql_len);
+    if (!SQL_SUCCEEDED(return_code)) {
+      if (IsConnectionFailure(SQL_HANDLE_STMT, handle)) {
+        ThrowExceptionWithDiagnostics("OdbcStatement->TryPrepare() SQLPrepare", SQL_HANDLE_STMT, handle,
+                                      return_code);
+      }
+      return false;
+    }
+    prepared = true;
+    this->sql_statement = sql_statement;
+
+    // drivers that defer SQLPrepare send the statement to the data source when its result is described
+    SQLSMALLINT num_result_cols = 0;
+    return_code = SQLNumResultCols(handle, &num_result_cols);
+    if (!SQL_SUCCEEDED(return_code)) {
+      if (IsConnectionFailure(SQL_HANDLE_STMT, handle)) {
+        ThrowExceptionWithDiagnostics("OdbcStatement->TryPrepare() SQLNumResultCols", SQL_HANDLE_STMT, handle,
+                                      return_code);
+      }
+      return false;
+    }
+
+    return num_result_cols == expected_columns;
   }
-  void SetAttribute(SQLINTEGER attribute, SQLPOINTER value) {
+  void SetAttribute(SQLINTEGER attribute, SQLPOINTER value, SQLINTEGER string_length = 0) {
     if (handle == SQL_NULL_HSTMT) {
       throw Exception("OdbcStatement->SetAttribute() handle has not been allocated. Call "
                       "OdbcStatement#Init() before OdbcStatement#SetAttribute()");
     }
 
-    auto return_code = SQLSetStmtAttr(handle, attribute, value, 0);
+    auto return_code = SQLSetStmtAttr(handle, attribute, value, string_length);
     if (return_code != SQL_SUCCESS && return_code != SQL_SUCCESS_WITH_INFO) {
       ThrowExceptionWithDiagnostics("OdbcStatement->SetAttribute() SQLSetStmtAttr", SQL_HANDLE_STMT, handle,
                                     return_code);
     }
   }
+  // Sets an optional attribute. Returns false when the driver doesn't support it
+  bool TrySetAttribute(SQLINTEGER attribute, SQLPOINTER value) {
+    if (handle == SQL_NULL_HSTMT) {
+      throw Exception("OdbcStatement->TrySetAttribute() handle has not been allocated. Call "
+                      "OdbcStatement#Init() before OdbcStatement#TrySetAttribute()");
+    }
+
+    return SQL_SUCCEEDED(SQLSetStmtAttr(handle, attribute, value, 0));
+  }
+  SQLULEN GetAttribute(SQLINTEGER attribute) {
+    if (handle == SQL_NULL_HSTMT) {
+      throw Exception("OdbcStatement->GetAttribute() handle has not been allocated. Call "
+                      "OdbcStatement#Init() before OdbcStatement#GetAttribute()");
+    }
+
+    SQLULEN value = 0;
+    auto return_code = SQLGetStmtAttr(handle, attribute, &value, 0, NULL);
+    if (!SQL_SUCCEEDED(return_code)) {
+      ThrowExceptionWithDiagnostics("OdbcStatement->GetAttribute() SQLGetStmtAttr", SQL_HANDLE_STMT, handle,
+                                    return_code);
+    }
+
+    return value;
+  }
   void BindColumn(SQLUSMALLINT column_number, SQLSMALLINT c_data_type, unsigned char *buffer,
                   SQLULEN column_buffer_length, SQLLEN *strlen_or_ind) {
     if (handle == SQL_NULL_HSTMT) {
@@ -208,6 +388,20 @@ public:
                                     return_code);
     }
   }
+  void BindParameter(SQLUSMALLINT parameter_number, SQLSMALLINT c_data_type, SQLSMALLINT sql_data_type,
+                     SQLULEN column_size, SQLPOINTER buffer, SQLLEN buffer_length, SQLLEN *strlen_or_ind) {
+    if (handle == SQL_NULL_HSTMT) {
+      throw Exception("OdbcStatement->BindParameter() handle has not been allocated. Call "
+                      "OdbcStatement#Init() before OdbcStatement#BindParameter()");
+    }
+
+    auto return_code = SQLBindParameter(handle, parameter_number, SQL_PARAM_INPUT, c_data_type,
+                                        sql_data_type, column_size, 0, buffer, buffer_length, strlen_or_ind);
+    if (!SQL_SUCCEEDED(return_code)) {
+      ThrowExceptionWithDiagnostics("OdbcStatement->BindParameter() SQLBindParameter", SQL_HANDLE_STMT,
+                                    handle, return_code);
+    }
+  }
   SQLSMALLINT NumResultCols() {
     if (handle == SQL_NULL_HSTMT) {
       throw Exception("OdbcStatement->NumResultCols() handle has not been allocated. Call "
@@ -243,12 +437,13 @@ public:
                                       handle, return_code);
       }
 
-      SqlDataTypeToCDataType(col_desc);
+      // types unknown to ODBC are resolved by OdbcDialect#BindColumnTypes()
+      TrySqlDataTypeToCDataType(col_desc);
     }
 
     return column_descriptions;
   }
-  void Execute(unique_ptr<OdbcStatementOptions> &opts) {
+  void Execute(const unique_ptr<OdbcStatementOptions> &opts) {
     if (handle == SQL_NULL_HSTMT) {
       throw Exception("OdbcStatement->Execute() handle is null");
     }
@@ -261,6 +456,16 @@ public:
 
     SetAttribute(SQL_ATTR_ROW_BIND_TYPE, SQL_BIND_BY_COLUMN);
     SetAttribute(SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)opts->row_array_size);
+    fetch_scroll = opts->fetch_scroll;
+    // the max rows are always set so a value from a previous execution of a cached statement doesn't
+    // remain. A SQL_ATTR_MAX_ROWS attribute the statement was configured with overrides a pushed down limit
+    auto max_rows = opts->max_rows;
+    for (auto &attribute : opts->attributes) {
+      if (attribute.attribute == SQL_ATTR_MAX_ROWS && !attribute.is_string) {
+        max_rows = attribute.integer_value;
+      }
+    }
+    TrySetAttribute(SQL_ATTR_MAX_ROWS, (SQLPOINTER)max_rows);
 
     auto return_code = SQLExecute(handle);
     if (return_code != SQL_SUCCESS && return_code != SQL_SUCCESS_WITH_INFO) {
@@ -286,7 +491,8 @@ public:
     SQLLEN rows_fetched = 0;
     SetAttribute(SQL_ATTR_ROWS_FETCHED_PTR, (SQLPOINTER)&rows_fetched);
 
-    auto return_code = SQLFetchScroll(handle, SQL_FETCH_NEXT, 0);
+    // ODBC 3 drivers fetch a rowset of SQL_ATTR_ROW_ARRAY_SIZE rows with either function
+    auto return_code = fetch_scroll ? SQLFetchScroll(handle, SQL_FETCH_NEXT, 0) : SQLFetch(handle);
     if (return_code != SQL_SUCCESS && return_code != SQL_SUCCESS_WITH_INFO &&
         return_code != SQL_NO_DATA_FOUND) {
       ThrowExceptionWithDiagnostics("OdbcStatement->Fetch() SQLFetchScroll", SQL_HANDLE_STMT, handle,
@@ -295,16 +501,194 @@ public:
 
     return rows_fetched;
   }
+  // Closes the cursor of an executing statement so the prepared statement can be executed again
+  void Close() {
+    if (handle == SQL_NULL_HSTMT) {
+      throw Exception("OdbcStatement->Close() handle is null");
+    }
+    if (!executing) {
+      return;
+    }
+
+    auto return_code = SQLFreeStmt(handle, SQL_CLOSE);
+    if (!SQL_SUCCEEDED(return_code)) {
+      ThrowExceptionWithDiagnostics("OdbcStatement->Close() SQLFreeStmt", SQL_HANDLE_STMT, handle,
+                                    return_code);
+    }
+
+    executing = false;
+  }
+  // Closes the cursor and releases column and parameter bindings so the prepared statement can be executed by
+  // a different owner without being prepared again
+  void Reset() {
+    if (handle == SQL_NULL_HSTMT) {
+      throw Exception("OdbcStatement->Reset() handle is null");
+    }
+
+    for (auto option : {SQL_CLOSE, SQL_UNBIND, SQL_RESET_PARAMS}) {
+      auto return_code = SQLFreeStmt(handle, option);
+      if (!SQL_SUCCEEDED(return_code)) {
+        ThrowExceptionWithDiagnostics("OdbcStatement->Reset() SQLFreeStmt", SQL_HANDLE_STMT, handle,
+                                      return_code);
+      }
+    }
+    // the previous owner's row status and rows fetched buffers are no longer valid
+    SetAttribute(SQL_ATTR_ROW_STATUS_PTR, NULL);
+    SetAttribute(SQL_ATTR_ROWS_FETCHED_PTR, NULL);
+
+    executing = false;
+  }
+
+  // Executes SQLTables to list the schemas of the data source. Read the result set with FetchRow()
+  void Schemas() {
+    if (handle == SQL_NULL_HSTMT) {
+      throw Exception("OdbcStatement->Schemas() handle is null");
+    }
+    if (executing) {
+      throw Exception("OdbcStatement->Schemas() previous statement is executing");
+    }
+
+    auto return_code = SQLTables(handle, (SQLCHAR *)"", 0, (SQLCHAR *)SQL_ALL_SCHEMAS, SQL_NTS,
+                                 (SQLCHAR *)"", 0, (SQLCHAR *)"", 0);
+    if (!SQL_SUCCEEDED(return_code)) {
+      ThrowExceptionWithDiagnostics("OdbcStatement->Schemas() SQLTables", SQL_HANDLE_STMT, handle,
+                                    return_code);
+    }
+
+    executing = true;
+  }
+  // Executes SQLTables to list the tables of a schema matching a pattern. Read the result set with FetchRow()
+  void Tables(const string &schema_name, const string &table_pattern, const string &table_types) {
+    if (handle == SQL_NULL_HSTMT) {
+      throw Exception("OdbcStatement->Tables() handle is null");
+    }
+    if (executing) {
+      throw Exception("OdbcStatement->Tables() previous statement is executing");
+    }
+
+    auto return_code =
+        SQLTables(handle, NULL, 0, (SQLCHAR *)schema_name.c_str(), (SQLSMALLINT)schema_name.length(),
+                  (SQLCHAR *)table_pattern.c_str(), (SQLSMALLINT)table_pattern.length(),
+                  (SQLCHAR *)table_types.c_str(), (SQLSMALLINT)table_types.length());
+    if (!SQL_SUCCEEDED(return_code)) {
+      ThrowExceptionWithDiagnostics("OdbcStatement->Tables() SQLTables", SQL_HANDLE_STMT, handle,
+                                    return_code);
+    }
+
+    executing = true;
+  }
+  // Executes SQLColumns to describe the columns of the tables in a schema matching a pattern. Read the result
+  // set with FetchRow()
+  void Columns(const string &schema_name, const string &table_pattern) {
+    if (handle == SQL_NULL_HSTMT) {
+      throw Exception("OdbcStatement->Columns() handle is null");
+    }
+    if (executing) {
+      throw Exception("OdbcStatement->Columns() previous statement is executing");
+    }
+
+    auto return_code =
+        SQLColumns(handle, NULL, 0, (SQLCHAR *)schema_name.c_str(), (SQLSMALLINT)schema_name.length(),
+                   (SQLCHAR *)table_pattern.c_str(), (SQLSMALLINT)table_pattern.length(), (SQLCHAR *)"%",
+                   SQL_NTS);
+    if (!SQL_SUCCEEDED(return_code)) {
+      ThrowExceptionWithDiagnostics("OdbcStatement->Columns() SQLColumns", SQL_HANDLE_STMT, handle,
+                                    return_code);
+    }
+
+    executing = true;
+  }
+  // Executes SQLGetTypeInfo to list the data types of the data source. Read the result set with FetchRow().
+  // Returns false when the driver doesn't support SQLGetTypeInfo
+  bool TryTypeInfo() {
+    if (handle == SQL_NULL_HSTMT) {
+      throw Exception("OdbcStatement->TryTypeInfo() handle is null");
+    }
+    if (executing) {
+      throw Exception("OdbcStatement->TryTypeInfo() previous statement is executing");
+    }
+
+    auto return_code = SQLGetTypeInfo(handle, SQL_ALL_TYPES);
+    if (!SQL_SUCCEEDED(return_code)) {
+      if (IsNotSupported(SQL_HANDLE_STMT, handle)) {
+        return false;
+      }
+      ThrowExceptionWithDiagnostics("OdbcStatement->TryTypeInfo() SQLGetTypeInfo", SQL_HANDLE_STMT, handle,
+                                    return_code);
+    }
+
+    executing = true;
+    return true;
+  }
+  // Fetches a single row of a catalog result set. Returns false when there are no more rows
+  bool FetchRow() {
+    if (!executing) {
+      throw Exception("OdbcStatement->FetchRow() statement is not executing");
+    }
+
+    auto return_code = SQLFetch(handle);
+    if (return_code == SQL_NO_DATA) {
+      return false;
+    }
+    if (!SQL_SUCCEEDED(return_code)) {
+      ThrowExceptionWithDiagnostics("OdbcStatement->FetchRow() SQLFetch", SQL_HANDLE_STMT, handle,
+                                    return_code);
+    }
+
+    return true;
+  }
+  // Returns a column of the current row as a string. NULL values are returned as an empty string
+  string GetString(SQLUSMALLINT column_number) {
+    SQLCHAR buffer[1024] = {0};
+    SQLLEN strlen_or_ind = 0;
+
+    auto return_code = SQLGetData(handle, column_number, SQL_C_CHAR, buffer, sizeof(buffer), &strlen_or_ind);
+    if (!SQL_SUCCEEDED(return_code)) {
+      ThrowExceptionWithDiagnostics("OdbcStatement->GetString() SQLGetData", SQL_HANDLE_STMT, handle,
+                                    return_code);
+    }
+    if (strlen_or_ind == SQL_NULL_DATA) {
+      return "";
+    }
+
+    return string((char *)buffer);
+  }
+  // Returns a column of the current row as an integer. NULL values are returned as 0
+  SQLINTEGER GetInteger(SQLUSMALLINT column_number) {
+    SQLINTEGER value = 0;
+    SQLLEN strlen_or_ind = 0;
+
+    auto return_code = SQLGetData(handle, column_number, SQL_C_SLONG, &value, sizeof(value), &strlen_or_ind);
+    if (!SQL_SUCCEEDED(return_code)) {
+      ThrowExceptionWithDiagnostics("OdbcStatement->GetInteger() SQLGetData", SQL_HANDLE_STMT, handle,
+                                    return_code);
+    }
+    if (strlen_or_ind == SQL_NULL_DATA) {
+      return 0;
+    }
+
+    return value;
+  }
 
-protected:
   static void SqlDataTypeToCDataType(OdbcColumnDescription *col_desc) {
+    if (!TrySqlDataTypeToCDataType(col_desc)) {
+      throw Exception("SqlDataTypeToCDataType() unknown sql_data_type=" +
+                      std::to_string(col_desc->sql_data_type));
+    }
+  }
+  // Returns false when the sql data type has no known C data type
+  static bool TrySqlDataTypeToCDataType(OdbcColumnDescription *col_desc) {
     // TODO:
     // - unixodbc doesn't seem to define all possible sql types
     switch (col_desc->sql_data_type) {
-    // case SQL_BIT:
-    //   col_desc->c_data_type = SQL_C_BIT;
-    //   col_desc->length = sizeof(SQLCHAR);
-    //   break;
+    case SQL_BIT:
+      col_desc->c_data_type = SQL_C_BIT;
+      col_desc->length = sizeof(SQLCHAR);
+      break;
+    case SQL_TINYINT:
+      col_desc->c_data_type = SQL_C_STINYINT;
+      col_desc->length = sizeof(SQLSCHAR);
+      break;
     case SQL_SMALLINT:
       col_desc->c_data_type = SQL_C_SHORT;
       col_desc->length = sizeof(SQLSMALLINT);
@@ -317,9 +701,12 @@ protected:
       col_desc->c_data_type = SQL_C_SBIGINT;
       col_desc->length = sizeof(SQLBIGINT);
       break;
-    // case SQL_DECFLOAT:
-    //   col_desc->c_data_type = SQL_C_CHAR;
-    //   break;
+    case SQL_DECFLOAT:
+      // up to 34 significant digits and exponents beyond the range of a DECIMAL or DOUBLE. Fetched as text so
+      // no precision is lost
+      col_desc->c_data_type = SQL_C_CHAR;
+      col_desc->length = col_desc->size + ODBC_DECFLOAT_TEXT_OVERHEAD;
+      break;
     case SQL_DECIMAL:
     case SQL_NUMERIC:
       col_desc->c_data_type = SQL_C_CHAR;
@@ -347,6 +734,17 @@ protected:
       col_desc->c_data_type = SQL_C_CHAR;
       col_desc->length = col_desc->size + sizeof(SQLCHAR);
       break;
+    case SQL_WCHAR:
+    case SQL_WVARCHAR:
+    case SQL_WLONGVARCHAR:
+    case SQL_GRAPHIC:
+    case SQL_VARGRAPHIC:
+    case SQL_LONGVARGRAPHIC:
+      // fetched as SQLWCHAR code units, independent of the client code page a driver converts SQL_C_CHAR to,
+      // and converted to UTF-8
+      col_desc->c_data_type = SQL_C_WCHAR;
+      col_desc->length = (col_desc->size + 1) * sizeof(SQLWCHAR);
+      break;
     case SQL_BINARY:
     // case SQL_BLOB:
     case SQL_VARBINARY:
@@ -358,9 +756,6 @@ protected:
     //   col_desc->c_data_type = SQL_C_BLOB_LOCATOR;
     //   break;
     // case SQL_DBCLOB:
-    // case SQL_GRAPHIC:
-    // case SQL_LONGVARGRAPHIC:
-    // case SQL_VARGRAPHIC:
     //   col_desc->c_data_type = SQL_C_DBCHAR;
     //   break;
     // case SQL_DBCLOB_LOCATOR:
@@ -388,10 +783,10 @@ protected:
     //   col_desc->c_data_type = SQL_C_BINARY;
     //   break;
     default:
-      throw Exception("SqlDataTypeToCDataType() unknown sql_data_type=" +
-                      std::to_string(col_desc->sql_data_type));
-      break;
+      return false;
     }
+
+    return true;
   }
 };
 } // namespace duckdb
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "odbc.hpp"
+#include "odbc_connection_pool.hpp"
+#include "odbc_dialect.hpp"
+
+#include "duckdb.hpp"
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/schema_catalog_entry.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/common/case_insensitive_map.hpp"
+#include "duckdb/parser/parsed_data/create_table_info.hpp"
+
+#include <mutex>
+
+namespace duckdb {
+class OdbcSchemaEntry;
+
+class OdbcTableEntry : public TableCatalogEntry {
+public:
+  OdbcTableEntry(Catalog &catalog, SchemaCatalogEntry &schema, CreateTableInfo &info,
+                 string _remote_schema_name, string _remote_table_name,
+                 vector<OdbcColumnDescription> _column_descriptions);
+
+  string remote_schema_name;
+  string remote_table_name;
+  vector<OdbcColumnDescription> column_descriptions;
+
+public:
+  unique_ptr<BaseStatistics> GetStatistics(ClientContext &context, column_t column_id) override;
+  TableFunction GetScanFunction(ClientContext &context, unique_ptr<FunctionData> &bind_data) override;
+  TableStorageInfo GetStorageInfo(ClientContext &context) override;
+};
+
+// Table names are listed through SQLTables once per schema. A table is described through SQLColumns the first
+// time it is referenced and cached for the lifetime of the attached catalog. Scanning the schema lists tables
+// that haven't been referenced yet without their columns.
+class OdbcSchemaEntry : public SchemaCatalogEntry {
+public:
+  OdbcSchemaEntry(Catalog &catalog, string name, string _remote_schema_name);
+
+  string remote_schema_name;
+
+public:
+  optional_ptr<CatalogEntry> CreateTable(CatalogTransaction transaction, BoundCreateTableInfo &info) override;
+  optional_ptr<CatalogEntry> CreateFunction(CatalogTransaction transaction,
+                                            CreateFunctionInfo &info) override;
+  optional_ptr<CatalogEntry> CreateIndex(ClientContext &context, CreateIndexInfo &info,
+                                         TableCatalogEntry &table) override;
+  optional_ptr<CatalogEntry> CreateView(CatalogTransaction transaction, CreateViewInfo &info) override;
+  optional_ptr<CatalogEntry> CreateSequence(CatalogTransaction transaction,
+                                            CreateSequenceInfo &info) override;
+  optional_ptr<CatalogEntry> CreateTableFunction(CatalogTransaction transaction,
+                                                 CreateTableFunctionInfo &info) override;
+  optional_ptr<CatalogEntry> CreateCopyFunction(CatalogTransaction transaction,
+                                                CreateCopyFunctionInfo &info) override;
+  optional_ptr<CatalogEntry> CreatePragmaFunction(CatalogTransaction transaction,
+                                                  CreatePragmaFunctionInfo &info) override;
+  optional_ptr<CatalogEntry> CreateCollation(CatalogTransaction transaction,
+                                             CreateCollationInfo &info) override;
+  optional_ptr<CatalogEntry> CreateType(CatalogTransaction transaction, CreateTypeInfo &info) override;
+  void Alter(ClientContext &context, AlterInfo &info) override;
+  void Scan(ClientContext &context, CatalogType type,
+            const std::function<void(CatalogEntry &)> &callback) override;
+  void Scan(CatalogType type, const std::function<void(CatalogEntry &)> &callback) override;
+  void DropEntry(ClientContext &context, DropInfo &info) override;
+  optional_ptr<CatalogEntry> GetEntry(CatalogTransaction transaction, CatalogType type,
+                                      const string &name) override;
+
+private:
+  std::mutex lock;
+  // described tables
+  case_insensitive_map_t<unique_ptr<OdbcTableEntry>> tables;
+  // remote table names listed through SQLTables. Resolves names that differ in case from the remote name
+  vector<string> remote_table_names;
+  bool remote_table_names_loaded;
+  // entries without columns of listed tables that haven't been described, keyed by their remote name
+  unordered_map<string, unique_ptr<OdbcTableEntry>> undescribed_tables;
+
+  optional_ptr<OdbcTableEntry> LoadTable(const string &remote_table_name);
+  void LoadRemoteTableNames();
+  optional_ptr<OdbcTableEntry> CreateTableEntry(const string &remote_table_name,
+                                                const vector<string> &column_names,
+                                                vector<OdbcColumnDescription> &column_descriptions);
+};
+
+// Catalog of an ODBC data source attached with ATTACH 'DSN=...' AS name (TYPE odbc). Schemas are listed
+// through SQLTables on first access. Table scans and metadata queries check out a connection of the catalog's
+// pool for as long as they run.
+class OdbcCatalog : public Catalog {
+public:
+  OdbcCatalog(AttachedDatabase &db, string _connection_string, idx_t statement_cache_capacity);
+
+  string connection_string;
+  shared_ptr<OdbcConnectionPool> pool;
+  shared_ptr<OdbcDialect> dialect;
+
+public:
+  void Initialize(bool load_builtin) override;
+  string GetCatalogType() override { return "odbc"; }
+
+  optional_ptr<CatalogEntry> CreateSchema(CatalogTransaction transaction, CreateSchemaInfo &info) override;
+  void ScanSchemas(ClientContext &context, std::function<void(SchemaCatalogEntry &)> callback) override;
+  optional_ptr<SchemaCatalogEntry> GetSchema(CatalogTransaction transaction, const string &schema_name,
+                                             OnEntryNotFound if_not_found,
+                                             QueryErrorContext error_context = QueryErrorContext()) override;
+
+  unique_ptr<PhysicalOperator> PlanCreateTableAs(ClientContext &context, LogicalCreateTable &op,
+                                                 unique_ptr<PhysicalOperator> plan) override;
+  unique_ptr<PhysicalOperator> PlanInsert(ClientContext &context, LogicalInsert &op,
+                                          unique_ptr<PhysicalOperator> plan) override;
+  unique_ptr<PhysicalOperator> PlanDelete(ClientContext &context, LogicalDelete &op,
+                                          unique_ptr<PhysicalOperator> plan) override;
+  unique_ptr<PhysicalOperator> PlanUpdate(ClientContext &context, LogicalUpdate &op,
+                                          unique_ptr<PhysicalOperator> plan) override;
+  unique_ptr<LogicalOperator> BindCreateIndex(Binder &binder, CreateStatement &stmt, TableCatalogEntry &table,
+                                              unique_ptr<LogicalOperator> plan) override;
+
+  DatabaseSize GetDatabaseSize(ClientContext &context) override;
+  bool InMemory() override { return false; }
+  string GetDBPath() override { return connection_string; }
+
+private:
+  std::mutex lock;
+  case_insensitive_map_t<unique_ptr<OdbcSchemaEntry>> schemas;
+  bool schemas_loaded;
+
+  void LoadSchemas();
+  void DropSchema(ClientContext &context, DropInfo &info) override;
+};
+} // namespace duckdb
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "odbc.hpp"
+#include "odbc_dialect.hpp"
+#include "odbc_statement_cache.hpp"
+
+#include "duckdb.hpp"
+
+#include <memory>
+#include <mutex>
+
+namespace duckdb {
+class OdbcConnectionPool;
+
+// A connection checked out of a pool for the exclusive use of its holder. The connection and its idle
+// prepared statements return to the pool when the lease is destroyed.
+class OdbcConnectionLease {
+public:
+  OdbcConnectionLease(shared_ptr<OdbcConnectionPool> _pool, shared_ptr<OdbcConnection> _connection,
+                      shared_ptr<OdbcStatementCache> _statement_cache);
+  ~OdbcConnectionLease();
+
+  shared_ptr<OdbcConnection> connection;
+  // prepared statements of the connection
+  shared_ptr<OdbcStatementCache> statement_cache;
+
+private:
+  shared_ptr<OdbcConnectionPool> pool;
+};
+
+// Connections to a single data source. An ODBC connection can't be used by several threads at once so every
+// scan and metadata query checks out a connection of its own. A connection is dialed when none is idle and
+// kept until the pool is destroyed. Attached catalogs own their pool while odbc_scan and odbc_lookup share
+// the pools of the database instance.
+class OdbcConnectionPool : public std::enable_shared_from_this<OdbcConnectionPool> {
+public:
+  OdbcConnectionPool(string _connection_string, vector<OdbcAttribute> _connection_attributes,
+                     idx_t _statement_cache_capacity);
+
+  string connection_string;
+  shared_ptr<OdbcEnvironment> environment;
+  // probed when the first connection is dialed
+  shared_ptr<OdbcDialect> dialect;
+
+public:
+  // Returns the database instance's pool of a connection string dialed with connection_attributes
+  static shared_ptr<OdbcConnectionPool> Get(ClientContext &context, const string &connection_string,
+                                            const vector<OdbcAttribute> &connection_attributes);
+  // The database instance's pools shared by odbc_scan and odbc_lookup
+  static vector<shared_ptr<OdbcConnectionPool>> GetAll(ClientContext &context);
+
+  shared_ptr<OdbcConnectionLease> Acquire();
+  // Statement cache stats summed over the connections of the pool
+  OdbcStatementCacheStats Stats();
+
+private:
+  friend class OdbcConnectionLease;
+
+  // set on every connection before it is dialed
+  vector<OdbcAttribute> connection_attributes;
+  // connection string with the driver's streaming options, see OdbcDialect::StreamingConnectionString. Empty
+  // until the first connection is dialed
+  string streaming_connection_string;
+  // idle prepared statements kept per connection
+  idx_t statement_cache_capacity;
+  std::mutex lock;
+  vector<std::pair<shared_ptr<OdbcConnection>, shared_ptr<OdbcStatementCache>>> idle;
+  // statement caches of every connection, idle or leased
+  vector<shared_ptr<OdbcStatementCache>> statement_caches;
+
+  shared_ptr<OdbcConnection> Dial(const string &dial_connection_string);
+  void Release(shared_ptr<OdbcConnection> connection, shared_ptr<OdbcStatementCache> statement_cache);
+};
+} // namespace duckdb
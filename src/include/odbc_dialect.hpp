@@ -0,0 +1,58 @@
+#pragma once
+
+#include "odbc.hpp"
+
+#include "duckdb.hpp"
+#include "duckdb/parser/parsed_data/sample_options.hpp"
+
+namespace duckdb {
+enum class OdbcDialectType : uint8_t { GENERIC, POSTGRES, MSSQL, DB2, ORACLE, SNOWFLAKE, MYSQL, BIG_QUERY };
+
+enum class OdbcLimitSyntax : uint8_t { LIMIT, TOP, FETCH_FIRST };
+
+// Capabilities of a driver and the SQL dialect of its data source. Probed through SQLGetInfo, SQLGetFunctions
+// and SQLGetTypeInfo on the first connection of a connection pool and shared by the pool's later connections.
+// A capability the driver doesn't report keeps the lowest common denominator default.
+struct OdbcDialect {
+  OdbcDialect()
+      : type(OdbcDialectType::GENERIC), fetch_scroll(true), max_row_array_size(STANDARD_VECTOR_SIZE),
+        limit_syntax(OdbcLimitSyntax::LIMIT) {}
+
+  string dbms_name;
+  // file name of the driver library, e.g. psqlodbcw.so
+  string driver_name;
+  OdbcDialectType type;
+  // empty when the data source doesn't support quoted identifiers
+  string identifier_quote;
+  // escapes wildcards in catalog function search patterns. Empty when the driver doesn't support escaping
+  string search_escape;
+  bool fetch_scroll;
+  // largest SQL_ATTR_ROW_ARRAY_SIZE accepted by the driver up to STANDARD_VECTOR_SIZE
+  SQLULEN max_row_array_size;
+  OdbcLimitSyntax limit_syntax;
+  // native type names of the data source's types keyed by their driver specific sql data type
+  unordered_map<SQLSMALLINT, string> type_names;
+
+public:
+  static shared_ptr<OdbcDialect> Probe(const shared_ptr<OdbcConnection> &connection);
+
+  string QuoteIdentifier(const string &identifier) const;
+  // Escapes the wildcards of a name passed as a search pattern to SQLTables or SQLColumns so it only matches
+  // itself. Without an escape character it can still match other names and results have to be filtered
+  string EscapeSearchPattern(const string &name) const;
+  // Restricts a query to its first limit rows
+  string Limit(const string &sql_statement, idx_t limit) const;
+  // Returns the clause sampling percentage percent of a table reference, or an empty string when the data
+  // source has no native syntax for the sample method or doesn't accept the percentage or seed. seed is -1
+  // when the sample isn't repeatable
+  string TableSample(SampleMethod method, double percentage, int64_t seed) const;
+  unique_ptr<OdbcStatementOptions> StatementOptions() const;
+  // Adds the options drivers need to stream a result set in row array sized blocks to a connection string,
+  // unless it already sets them. psqlODBC reads the whole result set into memory before the first row is
+  // fetched unless it's told to fetch through a cursor with UseDeclareFetch
+  string StreamingConnectionString(const string &connection_string) const;
+  // Picks the C data type each column is bound with. Driver specific sql data types unknown to ODBC are
+  // resolved through the native type name reported by SQLGetTypeInfo
+  void BindColumnTypes(vector<OdbcColumnDescription> &column_descriptions) const;
+};
+} // namespace duckdb
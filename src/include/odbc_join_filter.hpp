@@ -0,0 +1,69 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/scalar_function.hpp"
+
+#include <cstdint>
+#include <mutex>
+#include <set>
+
+namespace duckdb {
+#define ODBC_JOIN_FILTER_MAX_DISTINCT_KEYS 1000
+// longest IN list, in characters, pushed into the remote query. Long string keys fall back sooner
+#define ODBC_JOIN_FILTER_MAX_IN_LIST_LENGTH 16384
+
+// Keys of a hash join's build side collected while the build side executes. The odbc_scan on the probe
+// side defers SQLExecute until its first fetch and appends the resulting predicate to the remote query.
+struct OdbcJoinFilter {
+  OdbcJoinFilter(string _column_name, bool _integer_keys)
+      : column_name(_column_name), integer_keys(_integer_keys), has_keys(false), min(0), max(0),
+        distinct_keys_length(0), distinct_overflow(false) {}
+
+  // remote column the predicate is applied to
+  string column_name;
+  bool integer_keys;
+
+  std::mutex lock;
+  bool has_keys;
+  std::int64_t min;
+  std::int64_t max;
+  // distinct keys rendered as SQL literals until more than ODBC_JOIN_FILTER_MAX_DISTINCT_KEYS are seen or
+  // their IN list grows past ODBC_JOIN_FILTER_MAX_IN_LIST_LENGTH
+  std::set<string> distinct_keys;
+  idx_t distinct_keys_length;
+  bool distinct_overflow;
+
+public:
+  static bool SupportsType(const LogicalType &type);
+
+  // Collects the keys of a chunk without holding the lock and merges them into the filter. Literals are no
+  // longer rendered once the distinct keys overflow
+  void Collect(Vector &keys, idx_t count);
+  // Returns the remote predicate restricting the probe side to the collected keys and resets the filter so
+  // the next execution of the plan collects its own keys. An IN list is used while the distinct keys fit and
+  // a range otherwise. Returns an empty string when no predicate applies.
+  string TakePredicate();
+  // Describes the filter in the plan before any key has been collected
+  string ToString() const;
+};
+
+struct OdbcJoinFilterFunctionData : public FunctionData {
+  OdbcJoinFilterFunctionData(shared_ptr<OdbcJoinFilter> _join_filter) : join_filter(_join_filter) {}
+
+  shared_ptr<OdbcJoinFilter> join_filter;
+
+public:
+  unique_ptr<FunctionData> Copy() const override {
+    return make_uniq<OdbcJoinFilterFunctionData>(join_filter);
+  }
+  bool Equals(const FunctionData &other) const override {
+    return join_filter == other.Cast<OdbcJoinFilterFunctionData>().join_filter;
+  }
+};
+
+// Passes every row of the build side and records its join keys into an OdbcJoinFilter
+class OdbcJoinFilterCollectFunction : public ScalarFunction {
+public:
+  OdbcJoinFilterCollectFunction(const LogicalType &key_type);
+};
+} // namespace duckdb
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "odbc.hpp"
+#include "odbc_connection_pool.hpp"
+#include "odbc_dialect.hpp"
+#include "odbc_scan.hpp"
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+#include "sql.h"
+#include "sqlext.h"
+
+namespace duckdb {
+#define ODBC_LOOKUP_DEFAULT_BATCH_SIZE 500
+// every key is a statement parameter. SQL Server accepts at most 2100 parameters per statement
+#define ODBC_LOOKUP_MAX_BATCH_SIZE 2000
+
+struct OdbcLookupBindData : public FunctionData {
+  string connection_string;
+  string schema_name;
+  string table_name;
+  string key_column;
+  // result column holding the key of each remote row
+  idx_t key_column_index;
+  // number of keys sent to the remote database per execution of the prepared statement
+  idx_t batch_size;
+  // keys are bound as SQL_BIGINT when the probe column is integral and SQL_VARCHAR otherwise
+  bool integer_keys;
+  string sql_statement;
+  shared_ptr<OdbcConnectionPool> pool;
+  shared_ptr<OdbcDialect> dialect;
+
+  vector<string> names;
+  vector<LogicalType> types;
+  vector<OdbcColumnDescription> column_descriptions;
+
+public:
+  unique_ptr<FunctionData> Copy() const override { throw NotImplementedException(""); }
+  bool Equals(const FunctionData &other) const override { throw NotImplementedException(""); }
+};
+
+struct OdbcLookupLocalState : public LocalTableFunctionState {
+  OdbcLookupLocalState(idx_t _batch_size, SQLINTEGER _row_array_size)
+      : row_status(vector<SQLUSMALLINT>(_row_array_size)), integer_keys(vector<std::int64_t>(_batch_size)),
+        string_keys(vector<string>(_batch_size)), key_indicators(vector<SQLLEN>(_batch_size)),
+        input_offset(0), fetched_offset(0), fetched_repeat(0) {}
+  ~OdbcLookupLocalState() {
+    if (lease && statement) {
+      lease->statement_cache->Release(std::move(statement));
+    }
+  }
+
+  // declared before statement so the statement is freed before the connection returns to the pool
+  shared_ptr<OdbcConnectionLease> lease;
+  unique_ptr<OdbcStatement> statement;
+  unique_ptr<OdbcStatementOptions> statement_opts;
+
+  vector<SQLUSMALLINT> row_status;
+  vector<OdbcColumnBinding> column_bindings;
+
+  // parameter buffers of the batch being executed
+  vector<std::int64_t> integer_keys;
+  vector<string> string_keys;
+  vector<SQLLEN> key_indicators;
+  // position of the next probe key in the current input chunk
+  idx_t input_offset;
+  // number of probe rows of each distinct key in the batch being executed
+  unordered_map<string, idx_t> key_counts;
+
+  // rowset fetched for the batch. Each row is returned once per probe row of its key
+  DataChunk fetched;
+  idx_t fetched_offset;
+  // times the row at fetched_offset has been returned
+  idx_t fetched_repeat;
+};
+
+class OdbcLookupFunction : public TableFunction {
+public:
+  OdbcLookupFunction();
+};
+} // namespace duckdb
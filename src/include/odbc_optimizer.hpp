@@ -0,0 +1,12 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/optimizer/optimizer_extension.hpp"
+
+namespace duckdb {
+class OdbcOptimizer {
+public:
+  static void Optimize(ClientContext &context, OptimizerExtensionInfo *info,
+                       unique_ptr<LogicalOperator> &plan);
+};
+} // namespace duckdb
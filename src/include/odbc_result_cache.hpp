@@ -0,0 +1,83 @@
+#pragma once
+
+#include "odbc.hpp"
+
+#include "duckdb.hpp"
+#include "duckdb/common/types/column/column_data_collection.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/storage/object_cache.hpp"
+
+#include <chrono>
+#include <list>
+#include <mutex>
+
+namespace duckdb {
+#define ODBC_RESULT_CACHE_DEFAULT_TTL_SECONDS 60
+#define ODBC_RESULT_CACHE_DEFAULT_MAX_SIZE_IN_BYTES (256 * 1024 * 1024)
+
+struct OdbcResultCacheEntry {
+  string key;
+  vector<string> names;
+  vector<LogicalType> types;
+  shared_ptr<ColumnDataCollection> collection;
+  std::chrono::steady_clock::time_point created_at;
+  idx_t size_in_bytes;
+
+  bool Expired(idx_t ttl_seconds) const {
+    return std::chrono::steady_clock::now() - created_at >= std::chrono::seconds(ttl_seconds);
+  }
+};
+
+struct OdbcResultCacheStats {
+  idx_t hits;
+  idx_t misses;
+  idx_t evictions;
+  idx_t entries;
+  idx_t size_in_bytes;
+};
+
+// Results of remote scans keyed by connection string and remote SQL. Chunks are held in a
+// ColumnDataCollection allocated through the buffer manager so they can be spilled to disk.
+class OdbcResultCache : public ObjectCacheEntry {
+public:
+  OdbcResultCache() : size_in_bytes(0), hits(0), misses(0), evictions(0) {}
+
+  static string ObjectType() { return "odbc_result_cache"; }
+  string GetObjectType() override { return ObjectType(); }
+
+  static shared_ptr<OdbcResultCache> Get(ClientContext &context);
+  // Results of the same SQL differ with the connection and statement attributes they're executed with, e.g.
+  // SQL_ATTR_MAX_ROWS or the transaction isolation level, so the attributes are part of the key
+  static string Key(const string &connection_string, const string &sql_statement,
+                    const vector<OdbcAttribute> &connection_attributes,
+                    const vector<OdbcAttribute> &statement_attributes);
+  static idx_t TtlSeconds(ClientContext &context);
+  static idx_t MaxSizeInBytes(ClientContext &context);
+
+  // Returns the live entry of key. Lookups don't count misses as the optimizer can still rule out caching the
+  // scan, Miss() is called once a scan goes on to populate the cache
+  shared_ptr<OdbcResultCacheEntry> Lookup(const string &key, idx_t ttl_seconds);
+  void Miss();
+  void Insert(shared_ptr<OdbcResultCacheEntry> entry, idx_t max_size_in_bytes);
+  OdbcResultCacheStats Stats();
+
+private:
+  typedef std::list<shared_ptr<OdbcResultCacheEntry>>::iterator lru_iterator_t;
+
+  std::mutex lock;
+  // most recently used entries are at the front
+  std::list<shared_ptr<OdbcResultCacheEntry>> lru;
+  unordered_map<string, lru_iterator_t> entries;
+  idx_t size_in_bytes;
+  idx_t hits;
+  idx_t misses;
+  idx_t evictions;
+
+  void Erase(lru_iterator_t it);
+};
+
+class OdbcResultCacheStatsFunction : public TableFunction {
+public:
+  OdbcResultCacheStatsFunction();
+};
+} // namespace duckdb
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "odbc.hpp"
+#include "odbc_connection_pool.hpp"
+#include "odbc_dialect.hpp"
+#include "odbc_join_filter.hpp"
+#include "odbc_result_cache.hpp"
+#include "odbc_statement_cache.hpp"
 
 #include "duckdb.hpp"
 #include "duckdb/common/exception_format_value.hpp"
@@ -9,25 +14,99 @@
 #include "sql.h"
 #include "sqlext.h"
 
+#include <atomic>
 #include <cstdint>
 #include <iostream>
+#include <mutex>
 #include <vector>
 
 namespace duckdb {
+// A connection of a scan across several data sources with compatible schemas
+struct OdbcScanShard {
+  string connection_string;
+  // declared before statement so the statement is freed before the connection returns to the pool
+  shared_ptr<OdbcConnectionLease> lease;
+  shared_ptr<OdbcConnection> connection;
+  unique_ptr<OdbcStatement> statement;
+  unique_ptr<OdbcStatementOptions> statement_opts;
+};
+
 struct OdbcScanBindData : public FunctionData {
+  OdbcScanBindData()
+      : joined(false), quote_identifiers(false), shard_id_column(false), cache(false), cache_max_size(0) {}
+  ~OdbcScanBindData() {
+    // statements re-prepared with join filter predicates are unlikely to be executed again
+    if (statement_cache && statement && statement->sql_statement == sql_statement) {
+      statement_cache->Release(std::move(statement));
+    }
+    for (auto &shard : shards) {
+      if (shard->statement && shard->statement->sql_statement == sql_statement) {
+        shard->lease->statement_cache->Release(std::move(shard->statement));
+      }
+    }
+  }
+
   string connection_string;
   string schema_name;
   string table_name;
-  shared_ptr<OdbcEnvironment> environment;
+  // remote query executed by the scan. When joined is set it is a remote join of several odbc_scan's
+  string sql_statement;
+  bool joined;
+  // remote sampling clause following the table reference in sql_statement
+  string sample_clause;
+  // connection checked out of a pool for as long as the scan exists. Declared before statement so the
+  // statement is freed before the connection returns to the pool
+  shared_ptr<OdbcConnectionLease> lease;
   shared_ptr<OdbcConnection> connection;
+  shared_ptr<OdbcDialect> dialect;
+  // quote the schema and table names. Set when they are exact remote names read from the driver's metadata
+  bool quote_identifiers;
   unique_ptr<OdbcStatement> statement;
   unique_ptr<OdbcStatementOptions> statement_opts;
+  // set when odbc_scan is given a list of connection strings. Each shard is scanned by its own thread with
+  // the shared column descriptions and statement is null
+  vector<unique_ptr<OdbcScanShard>> shards;
+  // append a column with the index of the shard each row was read from
+  bool shard_id_column;
+  // cache of the leased connection the statement is returned to when the scan is destroyed
+  shared_ptr<OdbcStatementCache> statement_cache;
+
+  bool cache;
+  string cache_key;
+  idx_t cache_max_size;
+  shared_ptr<OdbcResultCacheEntry> cached_result;
+  // pool the scan's connection is checked out of. Scans are only joined remotely when they share a pool
+  shared_ptr<OdbcConnectionPool> pool;
+  // statement attributes a scan bound to a cached result executes with once the result expires
+  vector<OdbcAttribute> statement_attributes;
+
+  // predicates from the build side of hash joins this scan probes. Appended to the remote query when the
+  // statement is executed on the first fetch
+  vector<shared_ptr<OdbcJoinFilter>> join_filters;
 
   vector<string> names;
   vector<LogicalType> types;
   vector<OdbcColumnDescription> column_descriptions;
+  // column names to reference in remote SQL that selects from this scan
+  vector<string> remote_names;
 
 public:
+  string TableReference() const {
+    auto schema = quote_identifiers ? dialect->QuoteIdentifier(schema_name) : schema_name;
+    auto table = quote_identifiers ? dialect->QuoteIdentifier(table_name) : table_name;
+    if (schema_name.empty()) {
+      return table;
+    }
+    return schema + "." + table;
+  }
+  // true when sql_statement is rewritten, e.g. joined, sampled or limited, rather than scanning the table
+  bool Rewritten() const { return sql_statement != "SELECT * FROM " + TableReference(); }
+  string FromClause() const {
+    if (Rewritten()) {
+      return "(" + sql_statement + ")";
+    }
+    return TableReference();
+  }
   unique_ptr<FunctionData> Copy() const override { throw NotImplementedException(""); }
   bool Equals(const FunctionData &other) const override { throw NotImplementedException(""); }
 };
@@ -61,19 +140,57 @@ struct OdbcColumnBinding {
 
 struct OdbcScanLocalState : public LocalTableFunctionState {
   OdbcScanLocalState(SQLINTEGER _row_array_size)
-      : offset(0), row_status(vector<SQLUSMALLINT>(_row_array_size)) {}
+      : row_status(vector<SQLUSMALLINT>(_row_array_size)), shard_index(DConstants::INVALID_INDEX) {}
 
-  idx_t offset;
   vector<SQLUSMALLINT> row_status;
   vector<OdbcColumnBinding> column_bindings;
+  // shard being fetched by this thread
+  idx_t shard_index;
 };
 
 struct OdbcScanGlobalState : public GlobalTableFunctionState {
-  OdbcScanGlobalState() {}
+  OdbcScanGlobalState() : next_shard(0), max_threads(1), executed(false), join_filters_taken(false) {}
+  ~OdbcScanGlobalState() {
+    if (lease && statement) {
+      lease->statement_cache->Release(std::move(statement));
+    }
+  }
+
+  // next shard to be claimed by a thread
+  std::atomic<idx_t> next_shard;
+  idx_t max_threads;
+  // set once the statement of a scan without shards has been executed
+  bool executed;
+
+  std::mutex lock;
+  // predicates of the join filters taken when the first statement is executed and applied to every shard
+  bool join_filters_taken;
+  vector<string> predicates;
+
+  idx_t MaxThreads() const override { return max_threads; }
+
+  // result served from the result cache. Checked against the TTL every time the scan is executed
+  shared_ptr<OdbcResultCacheEntry> cached_result;
+  // replays a result served from the result cache
+  ColumnDataScanState cache_scan_state;
+  // statement executed when the cached result the scan was bound to expired before the scan was executed,
+  // e.g. by a prepared statement executed again. Declared after lease so it is freed first
+  shared_ptr<OdbcConnectionLease> lease;
+  unique_ptr<OdbcStatement> statement;
+  unique_ptr<OdbcStatementOptions> statement_opts;
+  vector<OdbcColumnDescription> column_descriptions;
+  // collects fetched chunks to populate the result cache. Reset when it grows past the cache size limit
+  shared_ptr<ColumnDataCollection> cache_collection;
 };
 
+LogicalType OdbcColumnToDuckDBLogicalType(OdbcColumnDescription col_desc);
+// Copies a rowset fetched into column bindings to the output chunk
+void OdbcWriteRows(vector<SQLUSMALLINT> &row_status_array, vector<OdbcColumnBinding> &column_bindings,
+                   SQLLEN rows_fetched, DataChunk &output);
+
 class OdbcScanFunction : public TableFunction {
 public:
-  OdbcScanFunction();
+  // connection_string_type is VARCHAR, or LIST(VARCHAR) to scan several shards
+  OdbcScanFunction(const LogicalType &connection_string_type = LogicalType::VARCHAR);
 };
 } // namespace duckdb
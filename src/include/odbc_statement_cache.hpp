@@ -0,0 +1,56 @@
+#pragma once
+
+#include "odbc.hpp"
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+#include <list>
+#include <mutex>
+
+namespace duckdb {
+#define ODBC_STATEMENT_CACHE_DEFAULT_SIZE 64
+
+struct OdbcStatementCacheStats {
+  idx_t hits;
+  idx_t misses;
+  idx_t evictions;
+  idx_t entries;
+};
+
+// Prepared statements of a connection keyed by their SQL and statement attributes. A statement is checked
+// out of the cache while a scan owns it and returned with its cursor closed and bindings released, so
+// executing the same SQL again skips SQLPrepare.
+class OdbcStatementCache {
+public:
+  OdbcStatementCache(shared_ptr<OdbcConnection> _connection, idx_t _capacity)
+      : connection(_connection), capacity(_capacity), hits(0), misses(0), evictions(0) {}
+
+  // Capacity of the statement caches of connection pools created with the global odbc_statement_cache_size
+  static idx_t Capacity(DatabaseInstance &db);
+
+  // Returns an idle statement configured with the attributes of opts and prepared with sql_statement,
+  // preparing a new one when none is cached
+  unique_ptr<OdbcStatement> Acquire(const string &sql_statement, const OdbcStatementOptions &opts);
+  void Release(unique_ptr<OdbcStatement> statement);
+  OdbcStatementCacheStats Stats();
+
+private:
+  typedef std::list<unique_ptr<OdbcStatement>>::iterator lru_iterator_t;
+
+  shared_ptr<OdbcConnection> connection;
+  std::mutex lock;
+  idx_t capacity;
+  // most recently released statements are at the front
+  std::list<unique_ptr<OdbcStatement>> lru;
+  unordered_map<string, lru_iterator_t> entries;
+  idx_t hits;
+  idx_t misses;
+  idx_t evictions;
+};
+
+class OdbcStatementCacheStatsFunction : public TableFunction {
+public:
+  OdbcStatementCacheStatsFunction();
+};
+} // namespace duckdb
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/storage/storage_extension.hpp"
+
+namespace duckdb {
+// Attaches ODBC data sources with ATTACH '<connection string>' AS name (TYPE odbc)
+class OdbcStorageExtension : public StorageExtension {
+public:
+  OdbcStorageExtension();
+};
+} // namespace duckdb
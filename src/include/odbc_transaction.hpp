@@ -0,0 +1,32 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/reference_map.hpp"
+#include "duckdb/transaction/transaction.hpp"
+#include "duckdb/transaction/transaction_manager.hpp"
+
+#include <mutex>
+
+namespace duckdb {
+// ODBC catalogs are read-only and every statement runs in the driver's autocommit mode so transactions only
+// track their lifetime
+class OdbcTransaction : public Transaction {
+public:
+  OdbcTransaction(TransactionManager &manager, ClientContext &context) : Transaction(manager, context) {}
+};
+
+class OdbcTransactionManager : public TransactionManager {
+public:
+  OdbcTransactionManager(AttachedDatabase &db);
+
+public:
+  Transaction &StartTransaction(ClientContext &context) override;
+  string CommitTransaction(ClientContext &context, Transaction &transaction) override;
+  void RollbackTransaction(Transaction &transaction) override;
+  void Checkpoint(ClientContext &context, bool force = false) override;
+
+private:
+  std::mutex lock;
+  reference_map_t<Transaction, unique_ptr<OdbcTransaction>> transactions;
+};
+} // namespace duckdb
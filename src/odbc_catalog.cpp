@@ -0,0 +1,395 @@
+#include "odbc_catalog.hpp"
+#include "odbc_scan.hpp"
+
+#include "duckdb.hpp"
+
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/parser/parsed_data/create_schema_info.hpp"
+#include "duckdb/storage/database_size.hpp"
+#include "duckdb/storage/table_storage_info.hpp"
+
+namespace duckdb {
+struct OdbcRemoteColumn {
+  string schema_name;
+  string table_name;
+  string column_name;
+  OdbcColumnDescription col_desc;
+};
+
+// Reads a row of an SQLColumns result set. Columns are read in increasing order as some drivers require
+static OdbcRemoteColumn ReadRemoteColumn(OdbcStatement &statement) {
+  OdbcRemoteColumn column;
+  column.schema_name = statement.GetString(2);
+  column.table_name = statement.GetString(3);
+  column.column_name = statement.GetString(4);
+  column.col_desc = {};
+  strncpy((char *)column.col_desc.name, column.column_name.c_str(), sizeof(column.col_desc.name) - 1);
+  column.col_desc.name_length = (SQLSMALLINT)strlen((char *)column.col_desc.name);
+  column.col_desc.sql_data_type = statement.GetInteger(5);
+  column.col_desc.size = statement.GetInteger(7);
+  column.col_desc.decimal_digits = statement.GetInteger(9);
+  column.col_desc.nullable = statement.GetInteger(11);
+
+  return column;
+}
+
+OdbcTableEntry::OdbcTableEntry(Catalog &catalog, SchemaCatalogEntry &schema, CreateTableInfo &info,
+                               string _remote_schema_name, string _remote_table_name,
+                               vector<OdbcColumnDescription> _column_descriptions)
+    : TableCatalogEntry(catalog, schema, info), remote_schema_name(_remote_schema_name),
+      remote_table_name(_remote_table_name), column_descriptions(_column_descriptions) {}
+
+unique_ptr<BaseStatistics> OdbcTableEntry::GetStatistics(ClientContext &context, column_t column_id) {
+  return nullptr;
+}
+
+TableFunction OdbcTableEntry::GetScanFunction(ClientContext &context, unique_ptr<FunctionData> &bind_data) {
+  auto &odbc_catalog = ParentCatalog().Cast<OdbcCatalog>();
+
+  auto result = make_uniq<OdbcScanBindData>();
+  result->connection_string = odbc_catalog.connection_string;
+  result->schema_name = remote_schema_name;
+  result->table_name = remote_table_name;
+  result->sql_statement = "SELECT * FROM " + result->TableReference();
+  result->pool = odbc_catalog.pool;
+  result->lease = result->pool->Acquire();
+  result->connection = result->lease->connection;
+  result->dialect = odbc_catalog.dialect;
+  result->quote_identifiers = true;
+  result->column_descriptions = column_descriptions;
+  for (auto &column : columns.Logical()) {
+    result->names.push_back(column.GetName());
+    result->remote_names.push_back(result->dialect->QuoteIdentifier(column.GetName()));
+    result->types.push_back(column.GetType());
+  }
+
+  // columns were described when the table entry was loaded so the statement only needs to be prepared, and
+  // not even that when a previous scan of the table on the same connection released it to the statement cache
+  result->statement_cache = result->lease->statement_cache;
+  result->statement_opts = result->dialect->StatementOptions();
+  result->statement = result->statement_cache->Acquire(result->sql_statement, *result->statement_opts);
+
+  bind_data = std::move(result);
+  return OdbcScanFunction();
+}
+
+TableStorageInfo OdbcTableEntry::GetStorageInfo(ClientContext &context) {
+  TableStorageInfo result;
+  return result;
+}
+
+OdbcSchemaEntry::OdbcSchemaEntry(Catalog &catalog, string name, string _remote_schema_name)
+    : SchemaCatalogEntry(catalog, std::move(name), false), remote_schema_name(_remote_schema_name),
+      remote_table_names_loaded(false) {}
+
+optional_ptr<CatalogEntry> OdbcSchemaEntry::CreateTable(CatalogTransaction transaction,
+                                                        BoundCreateTableInfo &info) {
+  throw BinderException("ODBC catalogs are read-only");
+}
+
+optional_ptr<CatalogEntry> OdbcSchemaEntry::CreateFunction(CatalogTransaction transaction,
+                                                           CreateFunctionInfo &info) {
+  throw BinderException("ODBC catalogs are read-only");
+}
+
+optional_ptr<CatalogEntry> OdbcSchemaEntry::CreateIndex(ClientContext &context, CreateIndexInfo &info,
+                                                        TableCatalogEntry &table) {
+  throw BinderException("ODBC catalogs are read-only");
+}
+
+optional_ptr<CatalogEntry> OdbcSchemaEntry::CreateView(CatalogTransaction transaction, CreateViewInfo &info) {
+  throw BinderException("ODBC catalogs are read-only");
+}
+
+optional_ptr<CatalogEntry> OdbcSchemaEntry::CreateSequence(CatalogTransaction transaction,
+                                                           CreateSequenceInfo &info) {
+  throw BinderException("ODBC catalogs are read-only");
+}
+
+optional_ptr<CatalogEntry> OdbcSchemaEntry::CreateTableFunction(CatalogTransaction transaction,
+                                                                CreateTableFunctionInfo &info) {
+  throw BinderException("ODBC catalogs are read-only");
+}
+
+optional_ptr<CatalogEntry> OdbcSchemaEntry::CreateCopyFunction(CatalogTransaction transaction,
+                                                               CreateCopyFunctionInfo &info) {
+  throw BinderException("ODBC catalogs are read-only");
+}
+
+optional_ptr<CatalogEntry> OdbcSchemaEntry::CreatePragmaFunction(CatalogTransaction transaction,
+                                                                 CreatePragmaFunctionInfo &info) {
+  throw BinderException("ODBC catalogs are read-only");
+}
+
+optional_ptr<CatalogEntry> OdbcSchemaEntry::CreateCollation(CatalogTransaction transaction,
+                                                            CreateCollationInfo &info) {
+  throw BinderException("ODBC catalogs are read-only");
+}
+
+optional_ptr<CatalogEntry> OdbcSchemaEntry::CreateType(CatalogTransaction transaction, CreateTypeInfo &info) {
+  throw BinderException("ODBC catalogs are read-only");
+}
+
+void OdbcSchemaEntry::Alter(ClientContext &context, AlterInfo &info) {
+  throw BinderException("ODBC catalogs are read-only");
+}
+
+void OdbcSchemaEntry::DropEntry(ClientContext &context, DropInfo &info) {
+  throw BinderException("ODBC catalogs are read-only");
+}
+
+void OdbcSchemaEntry::Scan(ClientContext &context, CatalogType type,
+                           const std::function<void(CatalogEntry &)> &callback) {
+  if (type != CatalogType::TABLE_ENTRY) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(lock);
+  if (!remote_table_names_loaded) {
+    LoadRemoteTableNames();
+  }
+  for (auto &remote_table_name : remote_table_names) {
+    auto table = tables.find(remote_table_name);
+    if (table != tables.end() && table->second->remote_table_name == remote_table_name) {
+      callback(*table->second);
+      continue;
+    }
+
+    // describing every table of a large schema would take a SQLColumns round trip each
+    auto &undescribed_table = undescribed_tables[remote_table_name];
+    if (!undescribed_table) {
+      CreateTableInfo info(*this, remote_table_name);
+      undescribed_table = make_uniq<OdbcTableEntry>(ParentCatalog(), *this, info, remote_schema_name,
+                                                    remote_table_name, vector<OdbcColumnDescription>());
+    }
+    callback(*undescribed_table);
+  }
+}
+
+void OdbcSchemaEntry::Scan(CatalogType type, const std::function<void(CatalogEntry &)> &callback) {
+  if (type != CatalogType::TABLE_ENTRY) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(lock);
+  for (auto &table : tables) {
+    callback(*table.second);
+  }
+}
+
+optional_ptr<CatalogEntry> OdbcSchemaEntry::GetEntry(CatalogTransaction transaction, CatalogType type,
+                                                     const string &name) {
+  if (type != CatalogType::TABLE_ENTRY) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> guard(lock);
+  auto entry = tables.find(name);
+  if (entry != tables.end()) {
+    return entry->second.get();
+  }
+
+  if (!remote_table_names_loaded) {
+    try {
+      LoadRemoteTableNames();
+    } catch (std::exception &ex) {
+      // the driver can't list tables. Describe the name as it was given
+      return LoadTable(name);
+    }
+  }
+
+  // remote catalogs are often case sensitive. Prefer the exact name and resolve other names against the
+  // remote table names. Names that aren't listed don't need a SQLColumns round trip
+  for (auto &remote_table_name : remote_table_names) {
+    if (remote_table_name == name) {
+      return LoadTable(remote_table_name);
+    }
+  }
+  for (auto &remote_table_name : remote_table_names) {
+    if (StringUtil::CIEquals(remote_table_name, name)) {
+      return LoadTable(remote_table_name);
+    }
+  }
+
+  return nullptr;
+}
+
+void OdbcSchemaEntry::LoadRemoteTableNames() {
+  auto &odbc_catalog = ParentCatalog().Cast<OdbcCatalog>();
+  auto lease = odbc_catalog.pool->Acquire();
+  OdbcStatement statement(lease->connection);
+  statement.Init();
+  statement.Tables(odbc_catalog.dialect->EscapeSearchPattern(remote_schema_name), "%", "TABLE,VIEW");
+
+  remote_table_names.clear();
+  while (statement.FetchRow()) {
+    // schema names are patterns in SQLTables so unescaped wildcard characters can match other schemas
+    if (!remote_schema_name.empty() && statement.GetString(2) != remote_schema_name) {
+      continue;
+    }
+    remote_table_names.push_back(statement.GetString(3));
+  }
+  remote_table_names_loaded = true;
+}
+
+optional_ptr<OdbcTableEntry> OdbcSchemaEntry::LoadTable(const string &remote_table_name) {
+  auto &odbc_catalog = ParentCatalog().Cast<OdbcCatalog>();
+  auto lease = odbc_catalog.pool->Acquire();
+  OdbcStatement statement(lease->connection);
+  statement.Init();
+  statement.Columns(odbc_catalog.dialect->EscapeSearchPattern(remote_schema_name),
+                    odbc_catalog.dialect->EscapeSearchPattern(remote_table_name));
+
+  vector<OdbcColumnDescription> column_descriptions;
+  vector<string> column_names;
+  while (statement.FetchRow()) {
+    auto column = ReadRemoteColumn(statement);
+    // schema and table names are patterns in SQLColumns so unescaped wildcard characters can match others
+    if ((!remote_schema_name.empty() && column.schema_name != remote_schema_name) ||
+        column.table_name != remote_table_name) {
+      continue;
+    }
+    column_descriptions.push_back(column.col_desc);
+    column_names.push_back(column.column_name);
+  }
+  if (column_descriptions.empty()) {
+    return nullptr;
+  }
+
+  return CreateTableEntry(remote_table_name, column_names, column_descriptions);
+}
+
+optional_ptr<OdbcTableEntry>
+OdbcSchemaEntry::CreateTableEntry(const string &remote_table_name, const vector<string> &column_names,
+                                  vector<OdbcColumnDescription> &column_descriptions) {
+  auto &odbc_catalog = ParentCatalog().Cast<OdbcCatalog>();
+  odbc_catalog.dialect->BindColumnTypes(column_descriptions);
+
+  CreateTableInfo info(*this, remote_table_name);
+  for (idx_t i = 0; i < column_descriptions.size(); i++) {
+    auto &col_desc = column_descriptions[i];
+    auto type = OdbcColumnToDuckDBLogicalType(col_desc);
+    if (type.id() == LogicalTypeId::INVALID) {
+      throw Exception("OdbcSchemaEntry->CreateTableEntry() unsupported sql_data_type=" +
+                      std::to_string(col_desc.sql_data_type) + " for column " + column_names[i]);
+    }
+    info.columns.AddColumn(ColumnDefinition(column_names[i], type));
+  }
+
+  auto table = make_uniq<OdbcTableEntry>(ParentCatalog(), *this, info, remote_schema_name, remote_table_name,
+                                         column_descriptions);
+  auto result = table.get();
+  tables[remote_table_name] = std::move(table);
+
+  return result;
+}
+
+OdbcCatalog::OdbcCatalog(AttachedDatabase &db, string _connection_string, idx_t statement_cache_capacity)
+    : Catalog(db), connection_string(_connection_string), schemas_loaded(false) {
+  pool =
+      make_shared<OdbcConnectionPool>(connection_string, vector<OdbcAttribute>(), statement_cache_capacity);
+  // dialing the first connection reports connection errors from ATTACH and probes the dialect
+  pool->Acquire();
+  dialect = pool->dialect;
+}
+
+void OdbcCatalog::Initialize(bool load_builtin) {}
+
+void OdbcCatalog::LoadSchemas() {
+  try {
+    auto lease = pool->Acquire();
+    OdbcStatement statement(lease->connection);
+    statement.Init();
+    statement.Schemas();
+    while (statement.FetchRow()) {
+      auto schema_name = statement.GetString(2);
+      if (!schema_name.empty() && schemas.find(schema_name) == schemas.end()) {
+        schemas[schema_name] = make_uniq<OdbcSchemaEntry>(*this, schema_name, schema_name);
+      }
+    }
+  } catch (std::exception &ex) {
+    // the driver can't list schemas
+  }
+
+  // data sources without schemas expose their tables through the default schema
+  if (schemas.empty()) {
+    schemas[DEFAULT_SCHEMA] = make_uniq<OdbcSchemaEntry>(*this, DEFAULT_SCHEMA, "");
+  }
+
+  schemas_loaded = true;
+}
+
+optional_ptr<CatalogEntry> OdbcCatalog::CreateSchema(CatalogTransaction transaction, CreateSchemaInfo &info) {
+  throw BinderException("ODBC catalogs are read-only");
+}
+
+void OdbcCatalog::DropSchema(ClientContext &context, DropInfo &info) {
+  throw BinderException("ODBC catalogs are read-only");
+}
+
+void OdbcCatalog::ScanSchemas(ClientContext &context, std::function<void(SchemaCatalogEntry &)> callback) {
+  std::lock_guard<std::mutex> guard(lock);
+  if (!schemas_loaded) {
+    LoadSchemas();
+  }
+  for (auto &schema : schemas) {
+    callback(*schema.second);
+  }
+}
+
+optional_ptr<SchemaCatalogEntry> OdbcCatalog::GetSchema(CatalogTransaction transaction,
+                                                        const string &schema_name,
+                                                        OnEntryNotFound if_not_found,
+                                                        QueryErrorContext error_context) {
+  std::lock_guard<std::mutex> guard(lock);
+  if (!schemas_loaded) {
+    LoadSchemas();
+  }
+
+  auto entry = schemas.find(schema_name);
+  if (entry != schemas.end()) {
+    return entry->second.get();
+  }
+  if (if_not_found == OnEntryNotFound::RETURN_NULL) {
+    return nullptr;
+  }
+  throw BinderException("Schema with name \"%s\" not found", schema_name);
+}
+
+unique_ptr<PhysicalOperator> OdbcCatalog::PlanCreateTableAs(ClientContext &context, LogicalCreateTable &op,
+                                                            unique_ptr<PhysicalOperator> plan) {
+  throw BinderException("ODBC catalogs are read-only");
+}
+
+unique_ptr<PhysicalOperator> OdbcCatalog::PlanInsert(ClientContext &context, LogicalInsert &op,
+                                                     unique_ptr<PhysicalOperator> plan) {
+  throw BinderException("ODBC catalogs are read-only");
+}
+
+unique_ptr<PhysicalOperator> OdbcCatalog::PlanDelete(ClientContext &context, LogicalDelete &op,
+                                                     unique_ptr<PhysicalOperator> plan) {
+  throw BinderException("ODBC catalogs are read-only");
+}
+
+unique_ptr<PhysicalOperator> OdbcCatalog::PlanUpdate(ClientContext &context, LogicalUpdate &op,
+                                                     unique_ptr<PhysicalOperator> plan) {
+  throw BinderException("ODBC catalogs are read-only");
+}
+
+unique_ptr<LogicalOperator> OdbcCatalog::BindCreateIndex(Binder &binder, CreateStatement &stmt,
+                                                         TableCatalogEntry &table,
+                                                         unique_ptr<LogicalOperator> plan) {
+  throw BinderException("ODBC catalogs are read-only");
+}
+
+DatabaseSize OdbcCatalog::GetDatabaseSize(ClientContext &context) {
+  DatabaseSize result;
+  result.total_blocks = 0;
+  result.block_size = 0;
+  result.free_blocks = 0;
+  result.used_blocks = 0;
+  result.bytes = 0;
+  result.wal_size = 0;
+  return result;
+}
+} // namespace duckdb
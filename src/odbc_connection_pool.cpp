@@ -0,0 +1,138 @@
+#include "odbc_connection_pool.hpp"
+
+#include "duckdb.hpp"
+
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/storage/object_cache.hpp"
+
+namespace duckdb {
+// Pools of the data sources scanned by odbc_scan and odbc_lookup keyed by connection string and connection
+// attributes
+class OdbcConnectionPools : public ObjectCacheEntry {
+public:
+  static string ObjectType() { return "odbc_connection_pools"; }
+  string GetObjectType() override { return ObjectType(); }
+
+  std::mutex lock;
+  unordered_map<string, shared_ptr<OdbcConnectionPool>> pools;
+};
+
+OdbcConnectionLease::OdbcConnectionLease(shared_ptr<OdbcConnectionPool> _pool,
+                                         shared_ptr<OdbcConnection> _connection,
+                                         shared_ptr<OdbcStatementCache> _statement_cache)
+    : connection(_connection), statement_cache(_statement_cache), pool(_pool) {}
+
+OdbcConnectionLease::~OdbcConnectionLease() {
+  pool->Release(std::move(connection), std::move(statement_cache));
+}
+
+OdbcConnectionPool::OdbcConnectionPool(string _connection_string,
+                                       vector<OdbcAttribute> _connection_attributes,
+                                       idx_t _statement_cache_capacity)
+    : connection_string(_connection_string), connection_attributes(_connection_attributes),
+      statement_cache_capacity(_statement_cache_capacity) {
+  environment = make_shared<OdbcEnvironment>();
+  environment->Init();
+}
+
+shared_ptr<OdbcConnectionPool> OdbcConnectionPool::Get(ClientContext &context,
+                                                       const string &connection_string,
+                                                       const vector<OdbcAttribute> &connection_attributes) {
+  auto key = connection_string;
+  for (auto &attribute : connection_attributes) {
+    key += '\0' + attribute.ToString();
+  }
+
+  auto pools = ObjectCache::GetObjectCache(context).GetOrCreate<OdbcConnectionPools>(
+      OdbcConnectionPools::ObjectType());
+  std::lock_guard<std::mutex> guard(pools->lock);
+  auto &pool = pools->pools[key];
+  if (!pool) {
+    auto statement_cache_capacity = OdbcStatementCache::Capacity(DatabaseInstance::GetDatabase(context));
+    pool =
+        make_shared<OdbcConnectionPool>(connection_string, connection_attributes, statement_cache_capacity);
+  }
+  return pool;
+}
+
+shared_ptr<OdbcConnection> OdbcConnectionPool::Dial(const string &dial_connection_string) {
+  auto connection = make_shared<OdbcConnection>();
+  connection->Init(environment);
+  for (auto &attribute : connection_attributes) {
+    connection->SetAttribute(attribute);
+  }
+  connection->Dial(dial_connection_string);
+  return connection;
+}
+
+vector<shared_ptr<OdbcConnectionPool>> OdbcConnectionPool::GetAll(ClientContext &context) {
+  auto pools = ObjectCache::GetObjectCache(context).GetOrCreate<OdbcConnectionPools>(
+      OdbcConnectionPools::ObjectType());
+  std::lock_guard<std::mutex> guard(pools->lock);
+
+  vector<shared_ptr<OdbcConnectionPool>> result;
+  for (auto &entry : pools->pools) {
+    result.push_back(entry.second);
+  }
+  return result;
+}
+
+shared_ptr<OdbcConnectionLease> OdbcConnectionPool::Acquire() {
+  string dial_connection_string;
+  shared_ptr<OdbcDialect> connection_dialect;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+
+    if (!idle.empty()) {
+      auto pooled = std::move(idle.back());
+      idle.pop_back();
+      return make_shared<OdbcConnectionLease>(shared_from_this(), pooled.first, pooled.second);
+    }
+    dial_connection_string =
+        streaming_connection_string.empty() ? connection_string : streaming_connection_string;
+    connection_dialect = dialect;
+  }
+
+  // the driver is only known once a connection is dialed. The first connection is dialed again when the
+  // driver needs options to stream result sets
+  auto connection = Dial(dial_connection_string);
+  if (!connection_dialect) {
+    connection_dialect = OdbcDialect::Probe(connection);
+  }
+  auto streaming = connection_dialect->StreamingConnectionString(connection_string);
+  if (streaming != dial_connection_string) {
+    connection = Dial(streaming);
+  }
+  auto statement_cache = make_shared<OdbcStatementCache>(connection, statement_cache_capacity);
+
+  std::lock_guard<std::mutex> guard(lock);
+  if (!dialect) {
+    dialect = connection_dialect;
+  }
+  streaming_connection_string = streaming;
+  statement_caches.push_back(statement_cache);
+
+  return make_shared<OdbcConnectionLease>(shared_from_this(), connection, statement_cache);
+}
+
+void OdbcConnectionPool::Release(shared_ptr<OdbcConnection> connection,
+                                 shared_ptr<OdbcStatementCache> statement_cache) {
+  std::lock_guard<std::mutex> guard(lock);
+
+  idle.emplace_back(std::move(connection), std::move(statement_cache));
+}
+
+OdbcStatementCacheStats OdbcConnectionPool::Stats() {
+  std::lock_guard<std::mutex> guard(lock);
+
+  OdbcStatementCacheStats stats = {0, 0, 0, 0};
+  for (auto &statement_cache : statement_caches) {
+    auto connection_stats = statement_cache->Stats();
+    stats.hits += connection_stats.hits;
+    stats.misses += connection_stats.misses;
+    stats.evictions += connection_stats.evictions;
+    stats.entries += connection_stats.entries;
+  }
+  return stats;
+}
+} // namespace duckdb
@@ -0,0 +1,250 @@
+#include "odbc_dialect.hpp"
+
+#include "duckdb.hpp"
+
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/unordered_set.hpp"
+
+namespace duckdb {
+static OdbcDialectType DialectType(const string &dbms_name) {
+  auto name = StringUtil::Lower(dbms_name);
+  if (StringUtil::StartsWith(name, "postgresql")) {
+    return OdbcDialectType::POSTGRES;
+  }
+  if (StringUtil::StartsWith(name, "microsoft sql server")) {
+    return OdbcDialectType::MSSQL;
+  }
+  if (StringUtil::StartsWith(name, "db2")) {
+    return OdbcDialectType::DB2;
+  }
+  if (StringUtil::StartsWith(name, "oracle")) {
+    return OdbcDialectType::ORACLE;
+  }
+  if (StringUtil::StartsWith(name, "snowflake")) {
+    return OdbcDialectType::SNOWFLAKE;
+  }
+  // the MongoDB BI connector reports itself as MySQL
+  if (StringUtil::StartsWith(name, "mysql") || StringUtil::StartsWith(name, "mariadb")) {
+    return OdbcDialectType::MYSQL;
+  }
+  if (StringUtil::Contains(name, "bigquery")) {
+    return OdbcDialectType::BIG_QUERY;
+  }
+  return OdbcDialectType::GENERIC;
+}
+
+shared_ptr<OdbcDialect> OdbcDialect::Probe(const shared_ptr<OdbcConnection> &connection) {
+  auto dialect = make_shared<OdbcDialect>();
+
+  // SQLGetInfo, SQLGetFunctions and SQLGetTypeInfo calls the driver doesn't support keep the default. Any
+  // other failure, e.g. a lost connection, is raised
+  if (connection->TryGetInfoString(SQL_DBMS_NAME, dialect->dbms_name)) {
+    dialect->type = DialectType(dialect->dbms_name);
+  }
+  switch (dialect->type) {
+  case OdbcDialectType::MSSQL:
+    dialect->limit_syntax = OdbcLimitSyntax::TOP;
+    break;
+  case OdbcDialectType::DB2:
+  case OdbcDialectType::ORACLE:
+    dialect->limit_syntax = OdbcLimitSyntax::FETCH_FIRST;
+    break;
+  default:
+    dialect->limit_syntax = OdbcLimitSyntax::LIMIT;
+    break;
+  }
+
+  connection->TryGetInfoString(SQL_DRIVER_NAME, dialect->driver_name);
+
+  // a space is returned when quoted identifiers aren't supported
+  string quote;
+  if (connection->TryGetInfoString(SQL_IDENTIFIER_QUOTE_CHAR, quote) && quote != " ") {
+    dialect->identifier_quote = quote;
+  }
+
+  connection->TryGetInfoString(SQL_SEARCH_PATTERN_ESCAPE, dialect->search_escape);
+  connection->TrySupportsFunction(SQL_API_SQLFETCHSCROLL, dialect->fetch_scroll);
+
+  // drivers without block cursors reject, or lower, the row array size
+  OdbcStatement statement(connection);
+  statement.Init();
+  if (statement.TrySetAttribute(SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)STANDARD_VECTOR_SIZE)) {
+    dialect->max_row_array_size =
+        MinValue<SQLULEN>(statement.GetAttribute(SQL_ATTR_ROW_ARRAY_SIZE), STANDARD_VECTOR_SIZE);
+  } else {
+    dialect->max_row_array_size = 1;
+  }
+  if (dialect->max_row_array_size == 0) {
+    dialect->max_row_array_size = 1;
+  }
+
+  OdbcStatement type_info(connection);
+  type_info.Init();
+  if (type_info.TryTypeInfo()) {
+    while (type_info.FetchRow()) {
+      auto type_name = type_info.GetString(1);
+      auto sql_data_type = (SQLSMALLINT)type_info.GetInteger(2);
+      if (dialect->type_names.find(sql_data_type) == dialect->type_names.end()) {
+        dialect->type_names[sql_data_type] = type_name;
+      }
+    }
+  }
+
+  return dialect;
+}
+
+string OdbcDialect::QuoteIdentifier(const string &identifier) const {
+  if (identifier_quote.empty()) {
+    return identifier;
+  }
+  auto escaped = StringUtil::Replace(identifier, identifier_quote, identifier_quote + identifier_quote);
+  return identifier_quote + escaped + identifier_quote;
+}
+
+string OdbcDialect::EscapeSearchPattern(const string &name) const {
+  if (search_escape.empty()) {
+    return name;
+  }
+  string result;
+  for (auto c : name) {
+    if (c == '_' || c == '%' || search_escape.find(c) != string::npos) {
+      result += search_escape;
+    }
+    result += c;
+  }
+  return result;
+}
+
+string OdbcDialect::Limit(const string &sql_statement, idx_t limit) const {
+  switch (limit_syntax) {
+  case OdbcLimitSyntax::TOP:
+    return "SELECT TOP " + std::to_string(limit) + " * FROM (" + sql_statement + ") t";
+  case OdbcLimitSyntax::FETCH_FIRST:
+    return sql_statement + " FETCH FIRST " + std::to_string(limit) + " ROWS ONLY";
+  default:
+    return sql_statement + " LIMIT " + std::to_string(limit);
+  }
+}
+
+string OdbcDialect::TableSample(SampleMethod method, double percentage, int64_t seed) const {
+  if (method != SampleMethod::SYSTEM_SAMPLE && method != SampleMethod::BERNOULLI_SAMPLE) {
+    return "";
+  }
+  auto system = method == SampleMethod::SYSTEM_SAMPLE;
+  auto percent = Value::DOUBLE(percentage).ToString();
+  auto repeatable = seed < 0 ? "" : " REPEATABLE (" + std::to_string(seed) + ")";
+  auto max_int32 = (int64_t)NumericLimits<int32_t>::Maximum();
+
+  // percentages and seeds outside the range a data source accepts are sampled locally rather than failing
+  // when the statement is executed
+  switch (type) {
+  case OdbcDialectType::POSTGRES:
+    if (percentage < 0 || percentage > 100) {
+      return "";
+    }
+    return string("TABLESAMPLE ") + (system ? "SYSTEM" : "BERNOULLI") + " (" + percent + ")" + repeatable;
+  case OdbcDialectType::DB2:
+    if (percentage <= 0 || percentage > 100 || seed > max_int32) {
+      return "";
+    }
+    return string("TABLESAMPLE ") + (system ? "SYSTEM" : "BERNOULLI") + " (" + percent + ")" + repeatable;
+  case OdbcDialectType::MSSQL:
+    // pages are sampled so only a system sample can be expressed
+    if (!system || percentage <= 0 || percentage > 100) {
+      return "";
+    }
+    return "TABLESAMPLE SYSTEM (" + percent + " PERCENT)" + repeatable;
+  case OdbcDialectType::ORACLE:
+    if (percentage < 0.000001 || percentage >= 100 || seed > (int64_t)NumericLimits<uint32_t>::Maximum()) {
+      return "";
+    }
+    return string("SAMPLE ") + (system ? "BLOCK " : "") + "(" + percent + ")" +
+           (seed < 0 ? "" : " SEED (" + std::to_string(seed) + ")");
+  case OdbcDialectType::SNOWFLAKE:
+    if (percentage < 0 || percentage > 100 || seed > max_int32) {
+      return "";
+    }
+    return string("SAMPLE ") + (system ? "SYSTEM" : "BERNOULLI") + " (" + percent + ")" +
+           (seed < 0 ? "" : " SEED (" + std::to_string(seed) + ")");
+  default:
+    return "";
+  }
+}
+
+unique_ptr<OdbcStatementOptions> OdbcDialect::StatementOptions() const {
+  return make_uniq<OdbcStatementOptions>(max_row_array_size, fetch_scroll);
+}
+
+// Lower cased keys of the key=value pairs of a connection string
+static unordered_set<string> ConnectionStringKeys(const string &connection_string) {
+  unordered_set<string> keys;
+  for (auto &pair : StringUtil::Split(connection_string, ';')) {
+    auto separator = pair.find('=');
+    auto key = pair.substr(0, separator);
+    StringUtil::Trim(key);
+    keys.insert(StringUtil::Lower(key));
+  }
+  return keys;
+}
+
+string OdbcDialect::StreamingConnectionString(const string &connection_string) const {
+  if (!StringUtil::Contains(StringUtil::Lower(driver_name), "psqlodbc")) {
+    return connection_string;
+  }
+
+  // psqlODBC also accepts the abbreviated keys B6 and A7
+  auto keys = ConnectionStringKeys(connection_string);
+  string options;
+  if (keys.find("usedeclarefetch") == keys.end() && keys.find("b6") == keys.end()) {
+    options += "UseDeclareFetch=1;";
+  }
+  if (keys.find("fetch") == keys.end() && keys.find("a7") == keys.end()) {
+    options += "Fetch=" + std::to_string(max_row_array_size) + ";";
+  }
+  if (options.empty()) {
+    return connection_string;
+  }
+  if (!connection_string.empty() && connection_string.back() != ';') {
+    options = ";" + options;
+  }
+  return connection_string + options;
+}
+
+// Standard sql data type of a native type name. Large objects aren't resolved as they can't be bound to a
+// fixed size buffer
+static SQLSMALLINT StandardSqlDataType(const string &type_name) {
+  auto name = StringUtil::Upper(type_name);
+  if (StringUtil::Contains(name, "LOB") || StringUtil::Contains(name, "LONG")) {
+    return SQL_UNKNOWN_TYPE;
+  }
+  if (StringUtil::Contains(name, "DECFLOAT")) {
+    return SQL_DECFLOAT;
+  }
+  if (StringUtil::Contains(name, "CHAR") || StringUtil::Contains(name, "GRAPHIC") ||
+      StringUtil::Contains(name, "STRING")) {
+    return SQL_WVARCHAR;
+  }
+  if (StringUtil::Contains(name, "BINARY")) {
+    return SQL_VARBINARY;
+  }
+  return SQL_UNKNOWN_TYPE;
+}
+
+void OdbcDialect::BindColumnTypes(vector<OdbcColumnDescription> &column_descriptions) const {
+  for (auto &col_desc : column_descriptions) {
+    if (OdbcStatement::TrySqlDataTypeToCDataType(&col_desc)) {
+      continue;
+    }
+
+    auto type_name = type_names.find(col_desc.sql_data_type);
+    if (type_name != type_names.end()) {
+      auto sql_data_type = StandardSqlDataType(type_name->second);
+      if (sql_data_type != SQL_UNKNOWN_TYPE) {
+        col_desc.sql_data_type = sql_data_type;
+      }
+    }
+
+    OdbcStatement::SqlDataTypeToCDataType(&col_desc);
+  }
+}
+} // namespace duckdb
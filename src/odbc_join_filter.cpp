@@ -0,0 +1,199 @@
+#include "odbc_join_filter.hpp"
+
+#include "duckdb.hpp"
+
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+
+namespace duckdb {
+bool OdbcJoinFilter::SupportsType(const LogicalType &type) {
+  switch (type.id()) {
+  case LogicalTypeId::TINYINT:
+  case LogicalTypeId::SMALLINT:
+  case LogicalTypeId::INTEGER:
+  case LogicalTypeId::BIGINT:
+  case LogicalTypeId::UTINYINT:
+  case LogicalTypeId::USMALLINT:
+  case LogicalTypeId::UINTEGER:
+  case LogicalTypeId::VARCHAR:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Keys of a single chunk
+struct OdbcJoinFilterKeys {
+  OdbcJoinFilterKeys(bool _collect_literals)
+      : collect_literals(_collect_literals), has_keys(false), min(0), max(0), literals_length(0),
+        overflow(false) {}
+
+  bool collect_literals;
+  bool has_keys;
+  std::int64_t min;
+  std::int64_t max;
+  std::set<string> literals;
+  idx_t literals_length;
+  bool overflow;
+
+  bool CollectsLiterals() const { return collect_literals && !overflow; }
+  void AddLiteral(string literal) {
+    auto length = literal.size() + 2;
+    if (literals.insert(std::move(literal)).second) {
+      literals_length += length;
+    }
+    if (literals.size() > ODBC_JOIN_FILTER_MAX_DISTINCT_KEYS ||
+        literals_length > ODBC_JOIN_FILTER_MAX_IN_LIST_LENGTH) {
+      overflow = true;
+      literals.clear();
+    }
+  }
+};
+
+template <class T>
+static void CollectIntegerKeys(UnifiedVectorFormat &format, idx_t count, OdbcJoinFilterKeys &keys) {
+  auto data = (const T *)format.data;
+  for (idx_t i = 0; i < count; i++) {
+    auto index = format.sel->get_index(i);
+    if (!format.validity.RowIsValid(index)) {
+      continue;
+    }
+
+    auto key = (std::int64_t)data[index];
+    if (!keys.has_keys || key < keys.min) {
+      keys.min = key;
+    }
+    if (!keys.has_keys || key > keys.max) {
+      keys.max = key;
+    }
+    keys.has_keys = true;
+    if (keys.CollectsLiterals()) {
+      keys.AddLiteral(std::to_string(key));
+    }
+  }
+}
+
+static void CollectStringKeys(UnifiedVectorFormat &format, idx_t count, OdbcJoinFilterKeys &keys) {
+  auto data = (const string_t *)format.data;
+  for (idx_t i = 0; i < count; i++) {
+    auto index = format.sel->get_index(i);
+    if (!format.validity.RowIsValid(index)) {
+      continue;
+    }
+
+    keys.has_keys = true;
+    if (!keys.CollectsLiterals()) {
+      // only whether the build side is empty still matters
+      return;
+    }
+    keys.AddLiteral("'" + StringUtil::Replace(data[index].GetString(), "'", "''") + "'");
+  }
+}
+
+void OdbcJoinFilter::Collect(Vector &keys, idx_t count) {
+  bool collect_literals;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    collect_literals = !distinct_overflow;
+  }
+
+  OdbcJoinFilterKeys chunk_keys(collect_literals);
+  UnifiedVectorFormat format;
+  keys.ToUnifiedFormat(count, format);
+  switch (keys.GetType().InternalType()) {
+  case PhysicalType::INT8:
+    CollectIntegerKeys<std::int8_t>(format, count, chunk_keys);
+    break;
+  case PhysicalType::INT16:
+    CollectIntegerKeys<std::int16_t>(format, count, chunk_keys);
+    break;
+  case PhysicalType::INT32:
+    CollectIntegerKeys<std::int32_t>(format, count, chunk_keys);
+    break;
+  case PhysicalType::INT64:
+    CollectIntegerKeys<std::int64_t>(format, count, chunk_keys);
+    break;
+  case PhysicalType::UINT8:
+    CollectIntegerKeys<std::uint8_t>(format, count, chunk_keys);
+    break;
+  case PhysicalType::UINT16:
+    CollectIntegerKeys<std::uint16_t>(format, count, chunk_keys);
+    break;
+  case PhysicalType::UINT32:
+    CollectIntegerKeys<std::uint32_t>(format, count, chunk_keys);
+    break;
+  case PhysicalType::VARCHAR:
+    CollectStringKeys(format, count, chunk_keys);
+    break;
+  default:
+    throw Exception("OdbcJoinFilter->Collect() unsupported key type " + keys.GetType().ToString());
+  }
+  if (!chunk_keys.has_keys) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(lock);
+
+  if (integer_keys) {
+    min = has_keys ? MinValue(min, chunk_keys.min) : chunk_keys.min;
+    max = has_keys ? MaxValue(max, chunk_keys.max) : chunk_keys.max;
+  }
+  has_keys = true;
+  if (distinct_overflow) {
+    return;
+  }
+  for (auto &literal : chunk_keys.literals) {
+    if (distinct_keys.insert(literal).second) {
+      distinct_keys_length += literal.size() + 2;
+    }
+  }
+  if (chunk_keys.overflow || distinct_keys.size() > ODBC_JOIN_FILTER_MAX_DISTINCT_KEYS ||
+      distinct_keys_length > ODBC_JOIN_FILTER_MAX_IN_LIST_LENGTH) {
+    distinct_overflow = true;
+    distinct_keys.clear();
+  }
+}
+
+string OdbcJoinFilter::TakePredicate() {
+  std::lock_guard<std::mutex> guard(lock);
+
+  string predicate;
+  if (!has_keys) {
+    // the build side is empty so no probe row can match
+    predicate = "1 = 0";
+  } else if (!distinct_overflow) {
+    vector<string> literals(distinct_keys.begin(), distinct_keys.end());
+    predicate = column_name + " IN (" + StringUtil::Join(literals, ", ") + ")";
+  } else if (integer_keys) {
+    predicate = column_name + " BETWEEN " + std::to_string(min) + " AND " + std::to_string(max);
+  }
+  // string ordering depends on the remote collation so a range of strings isn't pushed
+
+  has_keys = false;
+  min = 0;
+  max = 0;
+  distinct_keys.clear();
+  distinct_keys_length = 0;
+  distinct_overflow = false;
+
+  return predicate;
+}
+
+string OdbcJoinFilter::ToString() const {
+  return column_name + " IN (build side)";
+}
+
+static void OdbcJoinFilterCollect(DataChunk &args, ExpressionState &state, Vector &result) {
+  auto &func_expr = state.expr.Cast<BoundFunctionExpression>();
+  auto &info = func_expr.bind_info->Cast<OdbcJoinFilterFunctionData>();
+  info.join_filter->Collect(args.data[0], args.size());
+
+  result.SetVectorType(VectorType::CONSTANT_VECTOR);
+  ConstantVector::GetData<bool>(result)[0] = true;
+}
+
+OdbcJoinFilterCollectFunction::OdbcJoinFilterCollectFunction(const LogicalType &key_type)
+    : ScalarFunction("odbc_join_filter_collect", {key_type}, LogicalType::BOOLEAN, OdbcJoinFilterCollect) {
+  side_effects = FunctionSideEffects::HAS_SIDE_EFFECTS;
+}
+} // namespace duckdb
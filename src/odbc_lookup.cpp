@@ -0,0 +1,285 @@
+#include "odbc_lookup.hpp"
+
+#include "duckdb.hpp"
+
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+static bool IsIntegerKeyType(const LogicalType &type) {
+  switch (type.id()) {
+  case LogicalTypeId::TINYINT:
+  case LogicalTypeId::SMALLINT:
+  case LogicalTypeId::INTEGER:
+  case LogicalTypeId::BIGINT:
+  case LogicalTypeId::UTINYINT:
+  case LogicalTypeId::USMALLINT:
+  case LogicalTypeId::UINTEGER:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Returns the key a probe value or a remote row's key value is counted under
+static string OdbcLookupKey(const OdbcLookupBindData &bind_data, const Value &value) {
+  if (bind_data.integer_keys) {
+    Value integer_value;
+    if (value.DefaultTryCastAs(LogicalType::BIGINT, integer_value, nullptr)) {
+      return integer_value.ToString();
+    }
+  }
+  return value.ToString();
+}
+
+// Binds the next batch of distinct non-null probe keys from the input chunk and executes the prepared
+// statement. Probe rows repeating a key of the batch are counted instead. Returns false once every key of the
+// input chunk has been looked up.
+static bool OdbcLookupExecuteBatch(const OdbcLookupBindData &bind_data, OdbcLookupLocalState &local_state,
+                                   DataChunk &input) {
+  local_state.key_counts.clear();
+  idx_t batch_count = 0;
+  while (local_state.input_offset < input.size()) {
+    auto key = input.GetValue(0, local_state.input_offset);
+    if (key.IsNull()) {
+      local_state.input_offset++;
+      continue;
+    }
+    auto key_string = OdbcLookupKey(bind_data, key);
+    auto key_count = local_state.key_counts.find(key_string);
+    if (key_count != local_state.key_counts.end()) {
+      key_count->second++;
+      local_state.input_offset++;
+      continue;
+    }
+    if (batch_count == bind_data.batch_size) {
+      break;
+    }
+    local_state.key_counts[key_string] = 1;
+    local_state.input_offset++;
+
+    if (bind_data.integer_keys) {
+      local_state.integer_keys[batch_count] = key.GetValue<std::int64_t>();
+    } else {
+      local_state.string_keys[batch_count] = key.ToString();
+    }
+    batch_count++;
+  }
+  if (batch_count == 0) {
+    return false;
+  }
+
+  // pad a partial batch with its last key so the statement prepared for batch_size parameters is reused
+  for (idx_t i = batch_count; i < bind_data.batch_size; i++) {
+    if (bind_data.integer_keys) {
+      local_state.integer_keys[i] = local_state.integer_keys[batch_count - 1];
+    } else {
+      local_state.string_keys[i] = local_state.string_keys[batch_count - 1];
+    }
+  }
+
+  for (idx_t i = 0; i < bind_data.batch_size; i++) {
+    if (bind_data.integer_keys) {
+      local_state.key_indicators[i] = 0;
+      local_state.statement->BindParameter(i + 1, SQL_C_SBIGINT, SQL_BIGINT, 0,
+                                           (SQLPOINTER)&local_state.integer_keys[i], 0,
+                                           &local_state.key_indicators[i]);
+    } else {
+      auto &key = local_state.string_keys[i];
+      local_state.key_indicators[i] = SQL_NTS;
+      local_state.statement->BindParameter(i + 1, SQL_C_CHAR, SQL_VARCHAR, MaxValue<idx_t>(key.length(), 1),
+                                           (SQLPOINTER)key.c_str(), key.length() + 1,
+                                           &local_state.key_indicators[i]);
+    }
+  }
+
+  local_state.statement->Execute(local_state.statement_opts);
+  return true;
+}
+
+// Copies fetched rows to the output once per probe row of their key, so the result doesn't depend on how
+// probe rows are batched
+static void OdbcLookupWriteMatches(const OdbcLookupBindData &bind_data, OdbcLookupLocalState &local_state,
+                                   DataChunk &output) {
+  auto &fetched = local_state.fetched;
+  idx_t count = 0;
+  while (local_state.fetched_offset < fetched.size() && count < STANDARD_VECTOR_SIZE) {
+    auto row = local_state.fetched_offset;
+    auto key = OdbcLookupKey(bind_data, fetched.GetValue(bind_data.key_column_index, row));
+    auto key_count = local_state.key_counts.find(key);
+    // a key that doesn't round trip, e.g. matched by a case insensitive collation, is returned once
+    auto repeat = key_count == local_state.key_counts.end() ? 1 : key_count->second;
+
+    while (local_state.fetched_repeat < repeat && count < STANDARD_VECTOR_SIZE) {
+      for (idx_t c = 0; c < fetched.ColumnCount(); c++) {
+        output.SetValue(c, count, fetched.GetValue(c, row));
+      }
+      local_state.fetched_repeat++;
+      count++;
+    }
+    if (local_state.fetched_repeat == repeat) {
+      local_state.fetched_offset++;
+      local_state.fetched_repeat = 0;
+    }
+  }
+
+  output.SetCardinality(count);
+}
+
+static OperatorResultType OdbcLookup(ExecutionContext &context, TableFunctionInput &data, DataChunk &input,
+                                     DataChunk &output) {
+  auto &bind_data = data.bind_data->Cast<OdbcLookupBindData>();
+  auto &local_state = data.local_state->Cast<OdbcLookupLocalState>();
+
+  while (true) {
+    if (local_state.fetched_offset < local_state.fetched.size()) {
+      OdbcLookupWriteMatches(bind_data, local_state, output);
+      return OperatorResultType::HAVE_MORE_OUTPUT;
+    }
+    if (local_state.statement->executing) {
+      local_state.fetched.Reset();
+      local_state.fetched_offset = 0;
+      auto rows_fetched = local_state.statement->Fetch();
+      if (rows_fetched > 0) {
+        OdbcWriteRows(local_state.row_status, local_state.column_bindings, rows_fetched, local_state.fetched);
+        continue;
+      }
+      local_state.statement->Close();
+    }
+
+    if (!OdbcLookupExecuteBatch(bind_data, local_state, input)) {
+      local_state.input_offset = 0;
+      return OperatorResultType::NEED_MORE_INPUT;
+    }
+  }
+}
+
+static string OdbcLookupStatement(const OdbcDialect &dialect, const string &schema_name,
+                                  const string &table_name, const string &key_column, idx_t batch_size) {
+  string sql_statement = "SELECT * FROM ";
+  if (!schema_name.empty()) {
+    sql_statement += dialect.QuoteIdentifier(schema_name) + ".";
+  }
+  sql_statement +=
+      dialect.QuoteIdentifier(table_name) + " WHERE " + dialect.QuoteIdentifier(key_column) + " IN (";
+  for (idx_t i = 0; i < batch_size; i++) {
+    sql_statement += i == 0 ? "?" : ", ?";
+  }
+  sql_statement += ")";
+
+  return sql_statement;
+}
+
+static unique_ptr<FunctionData> OdbcLookupBind(ClientContext &context, TableFunctionBindInput &input,
+                                               vector<LogicalType> &return_types, vector<string> &names) {
+  if (input.input_table_types.size() != 1) {
+    throw BinderException("odbc_lookup expects a subquery returning a single key column");
+  }
+
+  auto bind_data = make_uniq<OdbcLookupBindData>();
+  bind_data->connection_string = input.inputs[0].GetValue<string>();
+  bind_data->schema_name = input.inputs[1].GetValue<string>();
+  bind_data->table_name = input.inputs[2].GetValue<string>();
+  bind_data->key_column = input.inputs[3].GetValue<string>();
+  bind_data->integer_keys = IsIntegerKeyType(input.input_table_types[0]);
+  bind_data->batch_size = ODBC_LOOKUP_DEFAULT_BATCH_SIZE;
+
+  for (auto &kv : input.named_parameters) {
+    if (kv.first == "batch_size") {
+      bind_data->batch_size = kv.second.GetValue<idx_t>();
+      if (bind_data->batch_size == 0 || bind_data->batch_size > ODBC_LOOKUP_MAX_BATCH_SIZE) {
+        throw BinderException("odbc_lookup batch_size must be between 1 and %d", ODBC_LOOKUP_MAX_BATCH_SIZE);
+      }
+    }
+  }
+
+  // the key column may be given quoted, as it was before names were quoted by the dialect
+  auto key_name = bind_data->key_column;
+  auto quote = key_name.empty() ? '\0' : key_name.front();
+  if (key_name.size() > 2 && (quote == '"' || quote == '`' || quote == '[')) {
+    key_name = key_name.substr(1, key_name.size() - 2);
+  }
+
+  // describe the result shape. Each thread executes the statement on a connection of its own, checking out
+  // the connection it was prepared on here when that connection is idle
+  bind_data->pool = OdbcConnectionPool::Get(context, bind_data->connection_string, vector<OdbcAttribute>());
+  auto lease = bind_data->pool->Acquire();
+  bind_data->dialect = bind_data->pool->dialect;
+  // names are quoted so they match the remote names exactly and can't inject SQL
+  bind_data->sql_statement = OdbcLookupStatement(*bind_data->dialect, bind_data->schema_name,
+                                                 bind_data->table_name, key_name, bind_data->batch_size);
+  auto statement =
+      lease->statement_cache->Acquire(bind_data->sql_statement, *bind_data->dialect->StatementOptions());
+  auto columns = statement->DescribeColumns();
+  lease->statement_cache->Release(std::move(statement));
+
+  bind_data->dialect->BindColumnTypes(columns);
+  for (int i = 0; i < columns.size(); i++) {
+    bind_data->column_descriptions.push_back(columns[i]);
+    bind_data->names.push_back(string((char *)columns[i].name));
+    bind_data->types.push_back(OdbcColumnToDuckDBLogicalType(columns[i]));
+  }
+
+  bind_data->key_column_index = DConstants::INVALID_INDEX;
+  for (idx_t i = 0; i < bind_data->names.size(); i++) {
+    if (StringUtil::CIEquals(bind_data->names[i], key_name)) {
+      bind_data->key_column_index = i;
+      break;
+    }
+  }
+  if (bind_data->key_column_index == DConstants::INVALID_INDEX) {
+    throw BinderException("odbc_lookup key column \"%s\" isn't returned by %s", bind_data->key_column,
+                          bind_data->table_name);
+  }
+
+  names = bind_data->names;
+  return_types = bind_data->types;
+
+  return std::move(bind_data);
+}
+
+static unique_ptr<LocalTableFunctionState> OdbcLookupInitLocalState(ExecutionContext &context,
+                                                                    TableFunctionInitInput &input,
+                                                                    GlobalTableFunctionState *global_state) {
+  auto &bind_data = input.bind_data->Cast<OdbcLookupBindData>();
+  auto statement_opts = bind_data.dialect->StatementOptions();
+  auto row_array_size = statement_opts->row_array_size;
+  auto local_state = make_uniq<OdbcLookupLocalState>(bind_data.batch_size, row_array_size);
+
+  local_state->lease = bind_data.pool->Acquire();
+  local_state->statement =
+      local_state->lease->statement_cache->Acquire(bind_data.sql_statement, *statement_opts);
+  local_state->statement_opts = std::move(statement_opts);
+
+  local_state->statement->SetAttribute(SQL_ATTR_ROW_STATUS_PTR, (SQLPOINTER)&local_state->row_status[0]);
+  local_state->fetched.Initialize(Allocator::DefaultAllocator(), bind_data.types);
+
+  for (SQLSMALLINT c = 0; c < bind_data.column_descriptions.size(); c++) {
+    auto col_desc = bind_data.column_descriptions.at(c);
+
+    local_state->column_bindings.emplace_back(col_desc, row_array_size);
+    auto column_binding = &local_state->column_bindings.at(c);
+    local_state->statement->BindColumn(c + 1, column_binding->c_data_type, column_binding->buffer,
+                                       column_binding->column_buffer_length, column_binding->strlen_or_ind);
+  }
+
+  return std::move(local_state);
+}
+
+static string OdbcLookupToString(const FunctionData *bind_data_p) {
+  D_ASSERT(bind_data_p);
+
+  auto bind_data = (const OdbcLookupBindData *)bind_data_p;
+  return bind_data->table_name;
+}
+
+OdbcLookupFunction::OdbcLookupFunction()
+    : TableFunction("odbc_lookup",
+                    {LogicalType::TABLE, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR,
+                     LogicalType::VARCHAR},
+                    nullptr, OdbcLookupBind, nullptr, OdbcLookupInitLocalState) {
+  in_out_function = OdbcLookup;
+  to_string = OdbcLookupToString;
+  named_parameters["batch_size"] = LogicalType::UBIGINT;
+}
+} // namespace duckdb
@@ -0,0 +1,601 @@
+#include "odbc_optimizer.hpp"
+#include "odbc_join_filter.hpp"
+#include "odbc_scan.hpp"
+
+#include "duckdb.hpp"
+
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_comparison_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckdb/planner/expression/bound_operator_expression.hpp"
+#include "duckdb/planner/logical_operator_visitor.hpp"
+#include "duckdb/planner/operator/logical_comparison_join.hpp"
+#include "duckdb/planner/operator/logical_filter.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/planner/operator/logical_limit.hpp"
+#include "duckdb/planner/operator/logical_sample.hpp"
+
+namespace duckdb {
+class OdbcColumnBindingRemapper : public LogicalOperatorVisitor {
+public:
+  OdbcColumnBindingRemapper(idx_t _from_table_index, idx_t _to_table_index, idx_t _column_offset)
+      : from_table_index(_from_table_index), to_table_index(_to_table_index), column_offset(_column_offset) {}
+
+  idx_t from_table_index;
+  idx_t to_table_index;
+  idx_t column_offset;
+
+protected:
+  unique_ptr<Expression> VisitReplace(BoundColumnRefExpression &expr,
+                                      unique_ptr<Expression> *expr_ptr) override {
+    if (expr.binding.table_index == from_table_index) {
+      expr.binding.table_index = to_table_index;
+      expr.binding.column_index += column_offset;
+    }
+    return nullptr;
+  }
+};
+
+static bool OptimizerSettingEnabled(ClientContext &context, const string &name) {
+  Value value;
+  if (!context.TryGetCurrentSetting(name, value) || value.IsNull()) {
+    return true;
+  }
+  return BooleanValue::Get(value);
+}
+
+static bool IsOdbcScan(LogicalOperator &op) {
+  if (op.type != LogicalOperatorType::LOGICAL_GET) {
+    return false;
+  }
+  return op.Cast<LogicalGet>().function.name == "odbc_scan";
+}
+
+// Returns the odbc_scan below a chain of filters when it can be folded into remote SQL
+static LogicalGet *FindRemoteInput(LogicalOperator &op) {
+  auto current = &op;
+  while (current->type == LogicalOperatorType::LOGICAL_FILTER) {
+    if (!current->Cast<LogicalFilter>().projection_map.empty()) {
+      return nullptr;
+    }
+    current = current->children[0].get();
+  }
+  if (!IsOdbcScan(*current)) {
+    return nullptr;
+  }
+
+  auto &get = current->Cast<LogicalGet>();
+  auto &bind_data = get.bind_data->Cast<OdbcScanBindData>();
+  if ((!bind_data.statement && bind_data.shards.empty()) || !get.projection_ids.empty() ||
+      !get.table_filters.filters.empty()) {
+    return nullptr;
+  }
+  for (auto &column_id : get.column_ids) {
+    if (column_id == COLUMN_IDENTIFIER_ROW_ID) {
+      return nullptr;
+    }
+  }
+
+  return &get;
+}
+
+// Moves the expressions of the filters above an odbc_scan into filters
+static void ExtractFilters(unique_ptr<LogicalOperator> &op, vector<unique_ptr<Expression>> &filters) {
+  auto current = &op;
+  while ((*current)->type == LogicalOperatorType::LOGICAL_FILTER) {
+    for (auto &expression : (*current)->expressions) {
+      filters.push_back(std::move(expression));
+    }
+    current = &(*current)->children[0];
+  }
+}
+
+static bool RemoteComparisonOperator(ExpressionType type, string &comparison) {
+  switch (type) {
+  case ExpressionType::COMPARE_EQUAL:
+    comparison = "=";
+    return true;
+  case ExpressionType::COMPARE_NOTEQUAL:
+    comparison = "<>";
+    return true;
+  case ExpressionType::COMPARE_LESSTHAN:
+    comparison = "<";
+    return true;
+  case ExpressionType::COMPARE_GREATERTHAN:
+    comparison = ">";
+    return true;
+  case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    comparison = "<=";
+    return true;
+  case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+    comparison = ">=";
+    return true;
+  default:
+    return false;
+  }
+}
+
+static bool RemoteColumnName(Expression &expr, LogicalGet &get, const OdbcScanBindData &bind_data,
+                             string &column_name) {
+  if (expr.type != ExpressionType::BOUND_COLUMN_REF) {
+    return false;
+  }
+  auto &colref = expr.Cast<BoundColumnRefExpression>();
+  if (colref.depth > 0 || colref.binding.table_index != get.table_index) {
+    return false;
+  }
+
+  // columns added by the scan, like shard_id, have no remote name
+  auto column_id = get.column_ids[colref.binding.column_index];
+  if (column_id >= bind_data.remote_names.size()) {
+    return false;
+  }
+  column_name = bind_data.remote_names[column_id];
+  return true;
+}
+
+// Renders a filter comparing a column of a remote join input with a constant, or testing it for NULL, as a
+// predicate of the remote WHERE clause. exact is false when the filter still has to be evaluated locally as
+// the data source may return rows it rejects
+static bool RemotePredicate(Expression &expr, LogicalGet &get, const OdbcScanBindData &bind_data,
+                            const string &alias, string &predicate, bool &exact) {
+  string column_name;
+  if (expr.type == ExpressionType::OPERATOR_IS_NULL || expr.type == ExpressionType::OPERATOR_IS_NOT_NULL) {
+    auto &operator_expr = expr.Cast<BoundOperatorExpression>();
+    if (!RemoteColumnName(*operator_expr.children[0], get, bind_data, column_name)) {
+      return false;
+    }
+    predicate = alias + "." + column_name +
+                (expr.type == ExpressionType::OPERATOR_IS_NULL ? " IS NULL" : " IS NOT NULL");
+    exact = true;
+    return true;
+  }
+  if (expr.GetExpressionClass() != ExpressionClass::BOUND_COMPARISON) {
+    return false;
+  }
+
+  auto &comparison = expr.Cast<BoundComparisonExpression>();
+  auto comparison_type = comparison.type;
+  auto column = comparison.left.get();
+  auto constant = comparison.right.get();
+  if (column->type == ExpressionType::VALUE_CONSTANT) {
+    std::swap(column, constant);
+    comparison_type = FlipComparisonExpression(comparison_type);
+  }
+  string comparison_operator;
+  if (constant->type != ExpressionType::VALUE_CONSTANT ||
+      !RemoteComparisonOperator(comparison_type, comparison_operator) ||
+      !RemoteColumnName(*column, get, bind_data, column_name)) {
+    return false;
+  }
+
+  auto &value = constant->Cast<BoundConstantExpression>().value;
+  if (value.IsNull()) {
+    return false;
+  }
+  string literal;
+  switch (value.type().id()) {
+  case LogicalTypeId::TINYINT:
+  case LogicalTypeId::SMALLINT:
+  case LogicalTypeId::INTEGER:
+  case LogicalTypeId::BIGINT:
+  case LogicalTypeId::UTINYINT:
+  case LogicalTypeId::USMALLINT:
+  case LogicalTypeId::UINTEGER:
+  case LogicalTypeId::UBIGINT:
+  case LogicalTypeId::DECIMAL:
+    literal = value.ToString();
+    exact = true;
+    break;
+  case LogicalTypeId::VARCHAR:
+    // the remote collation can order and compare strings differently, e.g. case insensitively, so only
+    // equality is pushed and it is checked again locally
+    if (comparison_type != ExpressionType::COMPARE_EQUAL) {
+      return false;
+    }
+    literal = "'" + StringUtil::Replace(StringValue::Get(value), "'", "''") + "'";
+    exact = false;
+    break;
+  default:
+    return false;
+  }
+
+  predicate = alias + "." + column_name + " " + comparison_operator + " " + literal;
+  return true;
+}
+
+// Collects the remote predicates of the filters above an input of a remote join. Filters the data source
+// evaluates exactly are added to pushed_filters so they are dropped from the local plan
+static void RemoteFilters(LogicalOperator &op, LogicalGet &get, const OdbcScanBindData &bind_data,
+                          const string &alias, vector<string> &predicates,
+                          unordered_set<Expression *> &pushed_filters) {
+  auto current = &op;
+  while (current->type == LogicalOperatorType::LOGICAL_FILTER) {
+    for (auto &expression : current->expressions) {
+      string predicate;
+      bool exact = false;
+      if (!RemotePredicate(*expression, get, bind_data, alias, predicate, exact)) {
+        continue;
+      }
+      predicates.push_back(predicate);
+      if (exact) {
+        pushed_filters.insert(expression.get());
+      }
+    }
+    current = current->children[0].get();
+  }
+}
+
+// Values of these types compare the same remotely as locally. Strings compare by the remote collation, which
+// can be case insensitive or ignore trailing spaces
+static bool RemoteExactType(const LogicalType &type) {
+  switch (type.id()) {
+  case LogicalTypeId::TINYINT:
+  case LogicalTypeId::SMALLINT:
+  case LogicalTypeId::INTEGER:
+  case LogicalTypeId::BIGINT:
+  case LogicalTypeId::UTINYINT:
+  case LogicalTypeId::USMALLINT:
+  case LogicalTypeId::UINTEGER:
+  case LogicalTypeId::UBIGINT:
+  case LogicalTypeId::DECIMAL:
+  case LogicalTypeId::DATE:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Replaces an inner join of two odbc_scan's on the same connection pool with a single odbc_scan that
+// executes the join remotely. The merged scan keeps the table index of the left input and the right
+// input's column bindings are shifted behind the left input's columns.
+static bool PushdownJoin(unique_ptr<LogicalOperator> &op, unique_ptr<LogicalOperator> &root) {
+  if (op->type != LogicalOperatorType::LOGICAL_COMPARISON_JOIN) {
+    return false;
+  }
+  auto &join = op->Cast<LogicalComparisonJoin>();
+  if (join.join_type != JoinType::INNER || join.conditions.empty()) {
+    return false;
+  }
+
+  auto left_get = FindRemoteInput(*join.children[0]);
+  auto right_get = FindRemoteInput(*join.children[1]);
+  if (!left_get || !right_get) {
+    return false;
+  }
+  auto &left_data = left_get->bind_data->Cast<OdbcScanBindData>();
+  auto &right_data = right_get->bind_data->Cast<OdbcScanBindData>();
+  // shards, and scans dialed or executed with different attributes, are joined locally
+  if (!left_data.pool || left_data.pool != right_data.pool || !left_data.shards.empty() ||
+      !right_data.shards.empty() ||
+      left_data.statement_opts->AttributesToString() != right_data.statement_opts->AttributesToString()) {
+    return false;
+  }
+
+  // string equalities are pushed as a superset of the local join and checked again locally, like string
+  // filters. Other string comparisons can't be pushed
+  vector<string> on_clauses;
+  vector<unique_ptr<Expression>> rechecked_conditions;
+  for (auto &condition : join.conditions) {
+    string comparison;
+    string left_column;
+    string right_column;
+    if (!RemoteComparisonOperator(condition.comparison, comparison) ||
+        !RemoteColumnName(*condition.left, *left_get, left_data, left_column) ||
+        !RemoteColumnName(*condition.right, *right_get, right_data, right_column)) {
+      return false;
+    }
+    auto &type = condition.left->return_type;
+    if (type != condition.right->return_type) {
+      return false;
+    }
+    if (!RemoteExactType(type)) {
+      if (type.id() != LogicalTypeId::VARCHAR || condition.comparison != ExpressionType::COMPARE_EQUAL) {
+        return false;
+      }
+      rechecked_conditions.push_back(make_uniq<BoundComparisonExpression>(
+          condition.comparison, condition.left->Copy(), condition.right->Copy()));
+    }
+    on_clauses.push_back("t0." + left_column + " " + comparison + " t1." + right_column);
+  }
+  vector<string> where_clauses;
+  unordered_set<Expression *> pushed_filters;
+  RemoteFilters(*join.children[0], *left_get, left_data, "t0", where_clauses, pushed_filters);
+  RemoteFilters(*join.children[1], *right_get, right_data, "t1", where_clauses, pushed_filters);
+
+  auto bind_data = make_uniq<OdbcScanBindData>();
+  bind_data->connection_string = left_data.connection_string;
+  bind_data->table_name = left_data.table_name + " JOIN " + right_data.table_name;
+  bind_data->joined = true;
+  bind_data->pool = left_data.pool;
+  bind_data->lease = left_data.lease;
+  bind_data->connection = left_data.connection;
+  bind_data->dialect = left_data.dialect;
+  bind_data->statement_cache = left_data.statement_cache;
+
+  vector<string> select_list;
+  for (auto &column_id : left_get->column_ids) {
+    auto alias = "c" + std::to_string(select_list.size());
+    select_list.push_back("t0." + left_data.remote_names[column_id] + " AS " + alias);
+    bind_data->names.push_back(left_data.names[column_id]);
+    bind_data->types.push_back(left_data.types[column_id]);
+  }
+  for (auto &column_id : right_get->column_ids) {
+    auto alias = "c" + std::to_string(select_list.size());
+    select_list.push_back("t1." + right_data.remote_names[column_id] + " AS " + alias);
+    bind_data->names.push_back(right_data.names[column_id]);
+    bind_data->types.push_back(right_data.types[column_id]);
+  }
+  for (idx_t i = 0; i < select_list.size(); i++) {
+    bind_data->remote_names.push_back("c" + std::to_string(i));
+  }
+
+  bind_data->sql_statement = "SELECT " + StringUtil::Join(select_list, ", ") + " FROM " +
+                             left_data.FromClause() + " t0 INNER JOIN " + right_data.FromClause() +
+                             " t1 ON " + StringUtil::Join(on_clauses, " AND ");
+  if (!where_clauses.empty()) {
+    bind_data->sql_statement += " WHERE " + StringUtil::Join(where_clauses, " AND ");
+  }
+
+  // drivers that defer SQLPrepare, like psqlODBC and MySQL, send the statement to the data source when its
+  // result is described. Describing it here makes a join the data source can't plan fall back before the
+  // plan is changed rather than fail when it is executed
+  bind_data->statement_opts = bind_data->dialect->StatementOptions();
+  bind_data->statement_opts->attributes = left_data.statement_opts->attributes;
+  try {
+    if (bind_data->statement_cache) {
+      bind_data->statement =
+          bind_data->statement_cache->Acquire(bind_data->sql_statement, *bind_data->statement_opts);
+    } else {
+      bind_data->statement = make_uniq<OdbcStatement>(bind_data->connection);
+      bind_data->statement->Init();
+      bind_data->statement->Configure(*bind_data->statement_opts);
+      bind_data->statement->Prepare(bind_data->sql_statement);
+    }
+    bind_data->column_descriptions = bind_data->statement->DescribeColumns();
+    bind_data->dialect->BindColumnTypes(bind_data->column_descriptions);
+  } catch (std::exception &ex) {
+    // the remote database can't plan the join. Keep joining locally
+    return false;
+  }
+  if (bind_data->column_descriptions.size() != bind_data->types.size()) {
+    return false;
+  }
+
+  auto table_index = left_get->table_index;
+  auto right_table_index = right_get->table_index;
+  auto left_column_count = left_get->column_ids.size();
+  auto returned_types = bind_data->types;
+  auto returned_names = bind_data->names;
+
+  auto get = make_uniq<LogicalGet>(table_index, left_get->function, std::move(bind_data), returned_types,
+                                   returned_names);
+  for (idx_t i = 0; i < returned_types.size(); i++) {
+    get->column_ids.push_back(i);
+  }
+  get->estimated_cardinality = join.estimated_cardinality;
+  get->has_estimated_cardinality = join.has_estimated_cardinality;
+
+  // filters on either input that the remote WHERE clause doesn't evaluate exactly are kept locally above the
+  // remote join
+  vector<unique_ptr<Expression>> input_filters;
+  ExtractFilters(join.children[0], input_filters);
+  ExtractFilters(join.children[1], input_filters);
+  vector<unique_ptr<Expression>> filters = std::move(rechecked_conditions);
+  for (auto &filter : input_filters) {
+    if (pushed_filters.find(filter.get()) == pushed_filters.end()) {
+      filters.push_back(std::move(filter));
+    }
+  }
+
+  unique_ptr<LogicalOperator> replacement = std::move(get);
+  if (!filters.empty()) {
+    auto filter = make_uniq<LogicalFilter>();
+    filter->expressions = std::move(filters);
+    filter->children.push_back(std::move(replacement));
+    replacement = std::move(filter);
+  }
+  op = std::move(replacement);
+
+  OdbcColumnBindingRemapper remapper(right_table_index, table_index, left_column_count);
+  remapper.VisitOperator(*root);
+
+  return true;
+}
+
+static void PushdownJoins(unique_ptr<LogicalOperator> &op, unique_ptr<LogicalOperator> &root) {
+  for (auto &child : op->children) {
+    PushdownJoins(child, root);
+  }
+  PushdownJoin(op, root);
+}
+
+// Replaces a percentage sample of an odbc_scan with the data source's sampling clause. Filters between the
+// sample and the scan stay local, which samples the same rows in distribution. Samples the data source can't
+// express are kept local.
+static void PushdownSample(unique_ptr<LogicalOperator> &op) {
+  if (op->type != LogicalOperatorType::LOGICAL_SAMPLE) {
+    return;
+  }
+  auto &sample = op->Cast<LogicalSample>();
+  auto &options = *sample.sample_options;
+  if (!options.is_percentage) {
+    return;
+  }
+
+  auto get = FindRemoteInput(*sample.children[0]);
+  if (!get) {
+    return;
+  }
+  auto &bind_data = get->bind_data->Cast<OdbcScanBindData>();
+  if (!bind_data.statement || !bind_data.dialect || bind_data.joined || !bind_data.sample_clause.empty()) {
+    return;
+  }
+
+  auto sample_clause =
+      bind_data.dialect->TableSample(options.method, options.sample_size.GetValue<double>(), options.seed);
+  if (sample_clause.empty()) {
+    return;
+  }
+  auto sql_statement = "SELECT * FROM " + bind_data.TableReference() + " " + sample_clause;
+  if (!bind_data.statement->TryPrepare(sql_statement, (SQLSMALLINT)bind_data.column_descriptions.size())) {
+    // the data source rejected the clause. Keep sampling locally
+    bind_data.statement->Prepare(bind_data.sql_statement);
+    return;
+  }
+  bind_data.sample_clause = sample_clause;
+  bind_data.sql_statement = sql_statement;
+  // the cache key is the unsampled statement
+  bind_data.cache = false;
+
+  op = std::move(sample.children[0]);
+}
+
+static void PushdownSamples(unique_ptr<LogicalOperator> &op) {
+  for (auto &child : op->children) {
+    PushdownSamples(child);
+  }
+  PushdownSample(op);
+}
+
+// Restricts the remote query of an odbc_scan below a constant limit with the data source's LIMIT, TOP or
+// FETCH FIRST syntax so the data source can stop producing rows once the limit is reached. SQL_ATTR_MAX_ROWS
+// is set as well for queries the data source rejects with the clause and for sharded scans, whose shards may
+// have different dialects. The limit is still applied locally as drivers may ignore the attribute.
+static void PushdownLimit(LogicalOperator &op) {
+  if (op.type != LogicalOperatorType::LOGICAL_LIMIT) {
+    return;
+  }
+  auto &limit = op.Cast<LogicalLimit>();
+  auto max_value = NumericLimits<int64_t>::Maximum();
+  if (limit.limit || limit.offset || limit.limit_val == max_value ||
+      limit.offset_val > max_value - limit.limit_val) {
+    return;
+  }
+
+  // projections don't change the number of rows
+  auto current = op.children[0].get();
+  while (current->type == LogicalOperatorType::LOGICAL_PROJECTION) {
+    current = current->children[0].get();
+  }
+  if (!IsOdbcScan(*current)) {
+    return;
+  }
+  auto &bind_data = current->Cast<LogicalGet>().bind_data->Cast<OdbcScanBindData>();
+  if (!bind_data.statement_opts) {
+    return;
+  }
+
+  auto max_rows = (SQLULEN)(limit.limit_val + limit.offset_val);
+  bind_data.statement_opts->max_rows = max_rows;
+  for (auto &shard : bind_data.shards) {
+    shard->statement_opts->max_rows = max_rows;
+  }
+  // a partial result can't be served to other queries
+  bind_data.cache = false;
+
+  if (!bind_data.statement || !bind_data.dialect) {
+    return;
+  }
+  auto sql_statement = bind_data.dialect->Limit(bind_data.sql_statement, max_rows);
+  if (!bind_data.statement->TryPrepare(sql_statement, (SQLSMALLINT)bind_data.column_descriptions.size())) {
+    bind_data.statement->Prepare(bind_data.sql_statement);
+    return;
+  }
+  bind_data.sql_statement = sql_statement;
+}
+
+static void PushdownLimits(LogicalOperator &op) {
+  for (auto &child : op.children) {
+    PushdownLimits(*child);
+  }
+  PushdownLimit(op);
+}
+
+static bool JoinFilterPreservesResult(JoinType join_type) {
+  switch (join_type) {
+  case JoinType::INNER:
+  case JoinType::SEMI:
+  case JoinType::RIGHT:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Restricts an odbc_scan on the probe side of a hash join to the keys of the join's build side. A filter
+// that records the keys is placed on the build side, which completes before the probe side starts fetching.
+static void PushdownJoinFilter(LogicalOperator &op) {
+  if (op.type != LogicalOperatorType::LOGICAL_COMPARISON_JOIN) {
+    return;
+  }
+  auto &join = op.Cast<LogicalComparisonJoin>();
+  if (!JoinFilterPreservesResult(join.join_type)) {
+    return;
+  }
+
+  auto get = FindRemoteInput(*join.children[0]);
+  if (!get) {
+    return;
+  }
+  auto &bind_data = get->bind_data->Cast<OdbcScanBindData>();
+
+  vector<unique_ptr<Expression>> collectors;
+  for (auto &condition : join.conditions) {
+    string column_name;
+    auto &key_type = condition.left->return_type;
+    if (condition.comparison != ExpressionType::COMPARE_EQUAL || key_type != condition.right->return_type ||
+        !OdbcJoinFilter::SupportsType(key_type) ||
+        !RemoteColumnName(*condition.left, *get, bind_data, column_name)) {
+      continue;
+    }
+
+    auto join_filter = make_shared<OdbcJoinFilter>(column_name, key_type.id() != LogicalTypeId::VARCHAR);
+    bind_data.join_filters.push_back(join_filter);
+    // the filtered result depends on the build side so it can't be served to other queries
+    bind_data.cache = false;
+
+    vector<unique_ptr<Expression>> arguments;
+    arguments.push_back(condition.right->Copy());
+    auto collect_data = make_uniq<OdbcJoinFilterFunctionData>(join_filter);
+    collectors.push_back(make_uniq<BoundFunctionExpression>(LogicalType::BOOLEAN,
+                                                            OdbcJoinFilterCollectFunction(key_type),
+                                                            std::move(arguments), std::move(collect_data)));
+  }
+  if (collectors.empty()) {
+    return;
+  }
+
+  auto filter = make_uniq<LogicalFilter>();
+  filter->expressions = std::move(collectors);
+  filter->estimated_cardinality = join.children[1]->estimated_cardinality;
+  filter->children.push_back(std::move(join.children[1]));
+  join.children[1] = std::move(filter);
+}
+
+static void PushdownJoinFilters(LogicalOperator &op) {
+  for (auto &child : op.children) {
+    PushdownJoinFilters(*child);
+  }
+  PushdownJoinFilter(op);
+}
+
+void OdbcOptimizer::Optimize(ClientContext &context, OptimizerExtensionInfo *info,
+                             unique_ptr<LogicalOperator> &plan) {
+  if (OptimizerSettingEnabled(context, "odbc_pushdown_samples")) {
+    PushdownSamples(plan);
+  }
+  if (OptimizerSettingEnabled(context, "odbc_pushdown_joins")) {
+    PushdownJoins(plan, plan);
+  }
+  if (OptimizerSettingEnabled(context, "odbc_pushdown_join_filters")) {
+    PushdownJoinFilters(*plan);
+  }
+  if (OptimizerSettingEnabled(context, "odbc_pushdown_limits")) {
+    PushdownLimits(*plan);
+  }
+}
+} // namespace duckdb
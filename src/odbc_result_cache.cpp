@@ -0,0 +1,151 @@
+#include "odbc_result_cache.hpp"
+
+#include "duckdb.hpp"
+
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/client_context.hpp"
+
+namespace duckdb {
+shared_ptr<OdbcResultCache> OdbcResultCache::Get(ClientContext &context) {
+  return ObjectCache::GetObjectCache(context).GetOrCreate<OdbcResultCache>(OdbcResultCache::ObjectType());
+}
+
+string OdbcResultCache::Key(const string &connection_string, const string &sql_statement,
+                            const vector<OdbcAttribute> &connection_attributes,
+                            const vector<OdbcAttribute> &statement_attributes) {
+  auto key = connection_string + '\0' + sql_statement + '\0';
+  for (auto &attribute : connection_attributes) {
+    key += attribute.ToString() + ";";
+  }
+  key += '\0';
+  for (auto &attribute : statement_attributes) {
+    key += attribute.ToString() + ";";
+  }
+  return key;
+}
+
+static idx_t GetSettingOrDefault(ClientContext &context, const string &name, idx_t default_value) {
+  Value value;
+  if (!context.TryGetCurrentSetting(name, value) || value.IsNull()) {
+    return default_value;
+  }
+  return value.GetValue<idx_t>();
+}
+
+idx_t OdbcResultCache::TtlSeconds(ClientContext &context) {
+  return GetSettingOrDefault(context, "odbc_result_cache_ttl_seconds", ODBC_RESULT_CACHE_DEFAULT_TTL_SECONDS);
+}
+
+idx_t OdbcResultCache::MaxSizeInBytes(ClientContext &context) {
+  return GetSettingOrDefault(context, "odbc_result_cache_max_size",
+                             ODBC_RESULT_CACHE_DEFAULT_MAX_SIZE_IN_BYTES);
+}
+
+shared_ptr<OdbcResultCacheEntry> OdbcResultCache::Lookup(const string &key, idx_t ttl_seconds) {
+  std::lock_guard<std::mutex> guard(lock);
+
+  auto it = entries.find(key);
+  if (it == entries.end()) {
+    return nullptr;
+  }
+
+  auto entry = *it->second;
+  if (entry->Expired(ttl_seconds)) {
+    Erase(it->second);
+    evictions++;
+    return nullptr;
+  }
+
+  lru.splice(lru.begin(), lru, it->second);
+  hits++;
+  return entry;
+}
+
+void OdbcResultCache::Miss() {
+  std::lock_guard<std::mutex> guard(lock);
+  misses++;
+}
+
+void OdbcResultCache::Insert(shared_ptr<OdbcResultCacheEntry> entry, idx_t max_size_in_bytes) {
+  if (entry->size_in_bytes > max_size_in_bytes) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(lock);
+
+  auto existing = entries.find(entry->key);
+  if (existing != entries.end()) {
+    Erase(existing->second);
+  }
+
+  while (!lru.empty() && size_in_bytes + entry->size_in_bytes > max_size_in_bytes) {
+    Erase(std::prev(lru.end()));
+    evictions++;
+  }
+
+  lru.push_front(entry);
+  entries[entry->key] = lru.begin();
+  size_in_bytes += entry->size_in_bytes;
+}
+
+OdbcResultCacheStats OdbcResultCache::Stats() {
+  std::lock_guard<std::mutex> guard(lock);
+
+  OdbcResultCacheStats stats;
+  stats.hits = hits;
+  stats.misses = misses;
+  stats.evictions = evictions;
+  stats.entries = entries.size();
+  stats.size_in_bytes = size_in_bytes;
+  return stats;
+}
+
+void OdbcResultCache::Erase(lru_iterator_t it) {
+  size_in_bytes -= (*it)->size_in_bytes;
+  entries.erase((*it)->key);
+  lru.erase(it);
+}
+
+struct OdbcResultCacheStatsGlobalState : public GlobalTableFunctionState {
+  OdbcResultCacheStatsGlobalState() : finished(false) {}
+
+  bool finished;
+};
+
+static unique_ptr<FunctionData> OdbcResultCacheStatsBind(ClientContext &context,
+                                                         TableFunctionBindInput &input,
+                                                         vector<LogicalType> &return_types,
+                                                         vector<string> &names) {
+  names = {"hits", "misses", "evictions", "entries", "size_in_bytes"};
+  return_types = {LogicalType::UBIGINT, LogicalType::UBIGINT, LogicalType::UBIGINT, LogicalType::UBIGINT,
+                  LogicalType::UBIGINT};
+
+  return nullptr;
+}
+
+static unique_ptr<GlobalTableFunctionState>
+OdbcResultCacheStatsInitGlobalState(ClientContext &context, TableFunctionInitInput &input) {
+  return make_uniq<OdbcResultCacheStatsGlobalState>();
+}
+
+static void OdbcResultCacheStatsScan(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+  auto &global_state = data.global_state->Cast<OdbcResultCacheStatsGlobalState>();
+  if (global_state.finished) {
+    return;
+  }
+
+  auto stats = OdbcResultCache::Get(context)->Stats();
+  output.SetValue(0, 0, Value::UBIGINT(stats.hits));
+  output.SetValue(1, 0, Value::UBIGINT(stats.misses));
+  output.SetValue(2, 0, Value::UBIGINT(stats.evictions));
+  output.SetValue(3, 0, Value::UBIGINT(stats.entries));
+  output.SetValue(4, 0, Value::UBIGINT(stats.size_in_bytes));
+  output.SetCardinality(1);
+
+  global_state.finished = true;
+}
+
+OdbcResultCacheStatsFunction::OdbcResultCacheStatsFunction()
+    : TableFunction("odbc_result_cache_stats", {}, OdbcResultCacheStatsScan, OdbcResultCacheStatsBind,
+                    OdbcResultCacheStatsInitGlobalState) {}
+} // namespace duckdb
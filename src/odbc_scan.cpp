@@ -2,10 +2,17 @@
 
 #include "duckdb.hpp"
 
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/unordered_set.hpp"
 #include "duckdb/function/table_function.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <thread>
 
 namespace duckdb {
-static LogicalType OdbcColumnToDuckDBLogicalType(OdbcColumnDescription col_desc) {
+LogicalType OdbcColumnToDuckDBLogicalType(OdbcColumnDescription col_desc) {
   if (col_desc.sql_data_type == SQL_CHAR) {
     return LogicalType::VARCHAR;
   }
@@ -15,18 +22,20 @@ static LogicalType OdbcColumnToDuckDBLogicalType(OdbcColumnDescription col_desc)
   if (col_desc.sql_data_type == SQL_LONGVARCHAR) {
     return LogicalType::VARCHAR;
   }
-  // // TODO:
-  // // - how should unicode variable length character strings be handled?
-  // // - VARCHAR_COLLATION(...)?
-  // if (col_desc.data_type == SQL_WCHAR) {
-  //   return LogicalType::VARCHAR;
-  // }
-  // if (col_desc.data_type == SQL_WVARCHAR) {
-  //   return LogicalType::VARCHAR;
-  // }
-  // if (col_desc.data_type == SQL_WLONGVARCHAR) {
-  //   return LogicalType::VARCHAR;
-  // }
+  // TODO:
+  // - VARCHAR_COLLATION(...)?
+  if (col_desc.sql_data_type == SQL_WCHAR || col_desc.sql_data_type == SQL_WVARCHAR ||
+      col_desc.sql_data_type == SQL_WLONGVARCHAR) {
+    return LogicalType::VARCHAR;
+  }
+  if (col_desc.sql_data_type == SQL_GRAPHIC || col_desc.sql_data_type == SQL_VARGRAPHIC ||
+      col_desc.sql_data_type == SQL_LONGVARGRAPHIC) {
+    return LogicalType::VARCHAR;
+  }
+  if (col_desc.sql_data_type == SQL_DECFLOAT) {
+    // exponents of up to 6144 don't fit a DECIMAL
+    return LogicalType::VARCHAR;
+  }
   if (col_desc.sql_data_type == SQL_DECIMAL) {
     return LogicalType::DECIMAL(col_desc.size, col_desc.decimal_digits);
   }
@@ -49,7 +58,7 @@ static LogicalType OdbcColumnToDuckDBLogicalType(OdbcColumnDescription col_desc)
     return LogicalType::DOUBLE;
   }
   if (col_desc.sql_data_type == SQL_BIT) {
-    return LogicalType::BIT;
+    return LogicalType::BOOLEAN;
   }
   if (col_desc.sql_data_type == SQL_TINYINT) {
     return LogicalType::TINYINT;
@@ -123,151 +132,650 @@ static LogicalType OdbcColumnToDuckDBLogicalType(OdbcColumnDescription col_desc)
   return LogicalType::INVALID;
 }
 
-static void OdbcScan(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
-  auto &bind_data = data.bind_data->Cast<OdbcScanBindData>();
-  auto local_state = data.local_state->Cast<OdbcScanLocalState>();
+static void OdbcScanPopulateResultCache(ClientContext &context, const OdbcScanBindData &bind_data,
+                                        OdbcScanGlobalState &global_state) {
+  auto entry = make_shared<OdbcResultCacheEntry>();
+  entry->key = bind_data.cache_key;
+  entry->names = bind_data.names;
+  entry->types = bind_data.types;
+  entry->collection = std::move(global_state.cache_collection);
+  entry->created_at = std::chrono::steady_clock::now();
+  entry->size_in_bytes = entry->collection->SizeInBytes();
 
-  auto rows_fetched = bind_data.statement->Fetch();
-  if (rows_fetched == 0) {
-    // finished returning values
-    return;
+  OdbcResultCache::Get(context)->Insert(std::move(entry), bind_data.cache_max_size);
+}
+
+// Converts a wide character value to UTF-8. SQLWCHAR is UTF-16, or UTF-32 when unixODBC is built with
+// wchar_t. Unpaired surrogates are replaced with U+FFFD
+static string OdbcWideToUtf8(const SQLWCHAR *value, idx_t length) {
+  string result;
+  result.reserve(length);
+  for (idx_t i = 0; i < length; i++) {
+    uint32_t code_point = value[i];
+    if (code_point >= 0xD800 && code_point <= 0xDBFF && i + 1 < length && value[i + 1] >= 0xDC00 &&
+        value[i + 1] <= 0xDFFF) {
+      code_point = 0x10000 + ((code_point - 0xD800) << 10) + (value[i + 1] - 0xDC00);
+      i++;
+    } else if ((code_point >= 0xD800 && code_point <= 0xDFFF) || code_point > 0x10FFFF) {
+      code_point = 0xFFFD;
+    }
+
+    if (code_point < 0x80) {
+      result += (char)code_point;
+    } else if (code_point < 0x800) {
+      result += (char)(0xC0 | (code_point >> 6));
+      result += (char)(0x80 | (code_point & 0x3F));
+    } else if (code_point < 0x10000) {
+      result += (char)(0xE0 | (code_point >> 12));
+      result += (char)(0x80 | ((code_point >> 6) & 0x3F));
+      result += (char)(0x80 | (code_point & 0x3F));
+    } else {
+      result += (char)(0xF0 | (code_point >> 18));
+      result += (char)(0x80 | ((code_point >> 12) & 0x3F));
+      result += (char)(0x80 | ((code_point >> 6) & 0x3F));
+      result += (char)(0x80 | (code_point & 0x3F));
+    }
   }
+  return result;
+}
 
+void OdbcWriteRows(vector<SQLUSMALLINT> &row_status_array, vector<OdbcColumnBinding> &column_bindings,
+                   SQLLEN rows_fetched, DataChunk &output) {
   for (auto r = 0; r < rows_fetched; r++) {
-    auto row_status = local_state.row_status[r];
+    auto row_status = row_status_array[r];
     if ((row_status == SQL_ROW_SUCCESS) || (row_status == SQL_ROW_SUCCESS_WITH_INFO)) {
-      for (auto c = 0; c < local_state.column_bindings.size(); c++) {
-        auto column_binding = &local_state.column_bindings.at(c);
+      for (auto c = 0; c < column_bindings.size(); c++) {
+        auto column_binding = &column_bindings.at(c);
         auto buffer = &column_binding->buffer[r * column_binding->column_buffer_length];
+        auto strlen_or_ind = column_binding->strlen_or_ind[r];
+        if (strlen_or_ind == SQL_NULL_DATA) {
+          output.SetValue(c, r, Value());
+          continue;
+        }
 
-        switch (column_binding->sql_data_type) {
-        case SQL_SMALLINT:
-          output.SetValue(c, local_state.offset, Value(*(std::int16_t *)buffer));
+        // the C data type the column was bound with determines the buffer layout
+        switch (column_binding->c_data_type) {
+        case SQL_C_BIT:
+          output.SetValue(c, r, Value::BOOLEAN(*(SQLCHAR *)buffer != 0));
+          break;
+        case SQL_C_STINYINT:
+          output.SetValue(c, r, Value::TINYINT(*(std::int8_t *)buffer));
+          break;
+        case SQL_C_SHORT:
+          output.SetValue(c, r, Value(*(std::int16_t *)buffer));
           break;
-        case SQL_INTEGER:
-          output.SetValue(c, local_state.offset, Value(*(std::int32_t *)buffer));
+        case SQL_C_LONG:
+          output.SetValue(c, r, Value(*(std::int32_t *)buffer));
           break;
-        case SQL_BIGINT:
-          output.SetValue(c, local_state.offset, Value(*(std::int64_t *)buffer));
+        case SQL_C_SBIGINT:
+          output.SetValue(c, r, Value(*(std::int64_t *)buffer));
           break;
-        case SQL_DOUBLE:
-        case SQL_FLOAT:
-          output.SetValue(c, local_state.offset, Value(*(double *)buffer));
+        case SQL_C_DOUBLE:
+          output.SetValue(c, r, Value(*(double *)buffer));
           break;
-        case SQL_DECIMAL:
-        case SQL_NUMERIC:
-          output.SetValue(c, local_state.offset, Value((char *)buffer));
+        case SQL_C_FLOAT:
+          output.SetValue(c, r, Value(*(float *)buffer));
           break;
-        case SQL_CHAR:
-        // case SQL_CLOB:
-        case SQL_VARCHAR:
-        case SQL_LONGVARCHAR: {
-          output.SetValue(c, local_state.offset, Value((char *)buffer));
+        // decimals and character strings of any width are bound as text
+        case SQL_C_CHAR:
+          output.SetValue(c, r, Value((char *)buffer));
+          break;
+        case SQL_C_WCHAR: {
+          auto value = (SQLWCHAR *)buffer;
+          // the length is in bytes without the null terminator. It exceeds the buffer when the value was
+          // truncated and is SQL_NO_TOTAL when the driver doesn't know it
+          auto max_length = column_binding->column_buffer_length / sizeof(SQLWCHAR) - 1;
+          idx_t length = 0;
+          if (strlen_or_ind >= 0) {
+            length = MinValue<idx_t>(strlen_or_ind / sizeof(SQLWCHAR), max_length);
+          } else {
+            while (length < max_length && value[length] != 0) {
+              length++;
+            }
+          }
+          output.SetValue(c, r, Value(OdbcWideToUtf8(value, length)));
           break;
         }
-        case SQL_BINARY:
-        // case SQL_BLOB:
-        case SQL_VARBINARY:
-        case SQL_LONGVARBINARY:
-          output.SetValue(c, local_state.offset, Value((char *)buffer));
+        case SQL_C_BINARY:
+          output.SetValue(c, r, Value((char *)buffer));
           break;
         default:
-          throw Exception("OdbcScanFunction#OdbcScan() unhandled output "
-                          "mapping from ODBC to DuckDB sql_data_type=" +
+          throw Exception("OdbcWriteRows() unhandled output mapping "
+                          "from ODBC to DuckDB sql_data_type=" +
                           std::to_string(column_binding->sql_data_type) +
                           ", c_data_type=" + std::to_string(column_binding->c_data_type));
         }
       }
     } else if (row_status == SQL_ROW_NOROW) {
-      throw Exception("OdbcScanFunction#OdbcScan() row status=" + std::to_string(row_status) +
+      throw Exception("OdbcWriteRows() row status=" + std::to_string(row_status) +
                       " SQL_ROW_NOROW");
     } else if (row_status == SQL_ROW_ERROR) {
-      throw Exception("OdbcScanFunction#OdbcScan() row status=" + std::to_string(row_status) +
+      throw Exception("OdbcWriteRows() row status=" + std::to_string(row_status) +
                       " SQL_ROW_ERROR");
     } else if (row_status == SQL_ROW_PROCEED) {
-      throw Exception("OdbcScanFunction#OdbcScan() row status=" + std::to_string(row_status) +
+      throw Exception("OdbcWriteRows() row status=" + std::to_string(row_status) +
                       " SQL_ROW_PROCEED");
     } else if (row_status == SQL_ROW_IGNORE) {
-      throw Exception("OdbcScanFunction#OdbcScan() row status=" + std::to_string(row_status) +
+      throw Exception("OdbcWriteRows() row status=" + std::to_string(row_status) +
                       " SQL_ROW_IGNORE");
     } else {
-      throw Exception("OdbcScanFunction#OdbcScan() row status=" + std::to_string(row_status) +
+      throw Exception("OdbcWriteRows() row status=" + std::to_string(row_status) +
                       " SQL_ROW_UNKNOWN");
     }
+  }
+
+  output.SetCardinality(rows_fetched);
+}
+
+// Takes the predicates of the scan's join filters once their build sides have completed. Taking them resets
+// the join filters so executing the plan again, e.g. as a prepared statement, uses its own keys
+static const vector<string> &OdbcScanPredicates(const OdbcScanBindData &bind_data,
+                                                OdbcScanGlobalState &global_state) {
+  std::lock_guard<std::mutex> guard(global_state.lock);
+
+  if (!global_state.join_filters_taken) {
+    for (auto &join_filter : bind_data.join_filters) {
+      auto predicate = join_filter->TakePredicate();
+      if (!predicate.empty()) {
+        global_state.predicates.push_back(predicate);
+      }
+    }
+    global_state.join_filters_taken = true;
+  }
+
+  return global_state.predicates;
+}
+
+// Executes the scan's statement restricted to the predicates of its join filters. The statement is prepared
+// again when the predicates differ from its previous execution. A filtered statement the data source rejects
+// falls back to the unfiltered statement, which returns the same join result.
+static void OdbcScanExecute(const OdbcScanBindData &bind_data, const vector<string> &predicates,
+                            OdbcStatement &statement,
+                            const unique_ptr<OdbcStatementOptions> &statement_opts) {
+  auto sql_statement = bind_data.sql_statement;
+  if (!predicates.empty()) {
+    sql_statement =
+        "SELECT * FROM " + bind_data.FromClause() + " t WHERE " + StringUtil::Join(predicates, " AND ");
+  }
+
+  if (statement.sql_statement != sql_statement &&
+      !statement.TryPrepare(sql_statement, (SQLSMALLINT)bind_data.column_descriptions.size())) {
+    statement.Prepare(bind_data.sql_statement);
+  }
+
+  statement.Execute(statement_opts);
+}
+
+static void OdbcScanBindColumns(const OdbcScanBindData &bind_data, OdbcStatement &statement,
+                                OdbcScanLocalState &local_state) {
+  statement.SetAttribute(SQL_ATTR_ROW_STATUS_PTR, (SQLPOINTER)&local_state.row_status[0]);
+
+  for (SQLSMALLINT c = 0; c < local_state.column_bindings.size(); c++) {
+    auto column_binding = &local_state.column_bindings.at(c);
+    statement.BindColumn(c + 1, column_binding->c_data_type, column_binding->buffer,
+                         column_binding->column_buffer_length, column_binding->strlen_or_ind);
+  }
+}
+
+// Threads claim shards until every shard has been fetched. A shard is executed once it is claimed
+static void OdbcScanShards(const OdbcScanBindData &bind_data, OdbcScanGlobalState &global_state,
+                           OdbcScanLocalState &local_state, DataChunk &output) {
+  while (true) {
+    if (local_state.shard_index == DConstants::INVALID_INDEX) {
+      auto shard_index = global_state.next_shard++;
+      if (shard_index >= bind_data.shards.size()) {
+        // finished returning values
+        return;
+      }
+
+      auto &shard = *bind_data.shards[shard_index];
+      OdbcScanBindColumns(bind_data, *shard.statement, local_state);
+      OdbcScanExecute(bind_data, OdbcScanPredicates(bind_data, global_state), *shard.statement,
+                      shard.statement_opts);
+      local_state.shard_index = shard_index;
+    }
+
+    auto &shard = *bind_data.shards[local_state.shard_index];
+    auto rows_fetched = shard.statement->Fetch();
+    if (rows_fetched == 0) {
+      shard.statement->Close();
+      local_state.shard_index = DConstants::INVALID_INDEX;
+      continue;
+    }
+
+    OdbcWriteRows(local_state.row_status, local_state.column_bindings, rows_fetched, output);
+    if (bind_data.shard_id_column) {
+      output.data.back().Reference(Value::INTEGER((int32_t)local_state.shard_index));
+    }
+    return;
+  }
+}
+
+static void OdbcScan(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+  auto &bind_data = data.bind_data->Cast<OdbcScanBindData>();
+  auto &global_state = data.global_state->Cast<OdbcScanGlobalState>();
+  auto &local_state = data.local_state->Cast<OdbcScanLocalState>();
+
+  if (global_state.cached_result) {
+    global_state.cached_result->collection->Scan(global_state.cache_scan_state, output);
+    return;
+  }
+  if (!bind_data.shards.empty()) {
+    OdbcScanShards(bind_data, global_state, local_state, output);
+    return;
+  }
+
+  // a scan whose cached result expired executes a statement of its own
+  auto &statement = global_state.statement ? *global_state.statement : *bind_data.statement;
+  auto &statement_opts = global_state.statement_opts ? global_state.statement_opts : bind_data.statement_opts;
+
+  // executing on the first fetch runs after the build side of a join probed by this scan has completed
+  if (!global_state.executed) {
+    OdbcScanExecute(bind_data, OdbcScanPredicates(bind_data, global_state), statement, statement_opts);
+    global_state.executed = true;
+  }
+
+  auto rows_fetched = statement.Fetch();
+  if (rows_fetched == 0) {
+    // finished returning values. Closing the cursor frees the remote result before the scan is destroyed
+    statement.Close();
+    if (global_state.cache_collection) {
+      OdbcScanPopulateResultCache(context, bind_data, global_state);
+    }
+    return;
+  }
 
-    // TODO:
-    // - handle STANDARD_VECTOR_SIZE
-    local_state.offset++;
-    output.SetCardinality(local_state.offset);
+  OdbcWriteRows(local_state.row_status, local_state.column_bindings, rows_fetched, output);
+
+  if (global_state.cache_collection) {
+    global_state.cache_collection->Append(output);
+    if (global_state.cache_collection->SizeInBytes() > bind_data.cache_max_size) {
+      global_state.cache_collection.reset();
+    }
+  }
+}
+
+static bool IsIntegerString(const string &value) {
+  if (value.empty()) {
+    return false;
+  }
+  for (idx_t i = 0; i < value.size(); i++) {
+    if (!StringUtil::CharacterIsDigit(value[i]) && !(i == 0 && value[i] == '-' && value.size() > 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Parses a decimal integer. Returns false when it doesn't fit an int64_t
+static bool TryParseInteger(const string &value, int64_t &result) {
+  errno = 0;
+  result = std::strtoll(value.c_str(), nullptr, 10);
+  return errno != ERANGE;
+}
+
+// Attributes are named by their SQL_ATTR_ constant or by the number of a driver specific attribute. Values of
+// integer attributes are integers or named by their SQL_ constant. Driver specific attributes with a value
+// that isn't an integer are passed as strings
+static vector<OdbcAttribute> OdbcScanParseAttributes(const string &parameter, const Value &map) {
+  static const unordered_map<string, SQLINTEGER> attribute_names = {
+      {"SQL_ATTR_ACCESS_MODE", SQL_ATTR_ACCESS_MODE},
+      {"SQL_ATTR_AUTOCOMMIT", SQL_ATTR_AUTOCOMMIT},
+      {"SQL_ATTR_CONCURRENCY", SQL_ATTR_CONCURRENCY},
+      {"SQL_ATTR_CONNECTION_TIMEOUT", SQL_ATTR_CONNECTION_TIMEOUT},
+      {"SQL_ATTR_CURRENT_CATALOG", SQL_ATTR_CURRENT_CATALOG},
+      {"SQL_ATTR_CURSOR_SENSITIVITY", SQL_ATTR_CURSOR_SENSITIVITY},
+      {"SQL_ATTR_CURSOR_TYPE", SQL_ATTR_CURSOR_TYPE},
+      {"SQL_ATTR_LOGIN_TIMEOUT", SQL_ATTR_LOGIN_TIMEOUT},
+      {"SQL_ATTR_MAX_LENGTH", SQL_ATTR_MAX_LENGTH},
+      {"SQL_ATTR_MAX_ROWS", SQL_ATTR_MAX_ROWS},
+      {"SQL_ATTR_NOSCAN", SQL_ATTR_NOSCAN},
+      {"SQL_ATTR_PACKET_SIZE", SQL_ATTR_PACKET_SIZE},
+      {"SQL_ATTR_QUERY_TIMEOUT", SQL_ATTR_QUERY_TIMEOUT},
+      {"SQL_ATTR_TXN_ISOLATION", SQL_ATTR_TXN_ISOLATION},
+  };
+  static const unordered_set<SQLINTEGER> string_attributes = {SQL_ATTR_CURRENT_CATALOG};
+  static const unordered_map<string, SQLULEN> value_names = {
+      {"SQL_MODE_READ_ONLY", SQL_MODE_READ_ONLY},
+      {"SQL_MODE_READ_WRITE", SQL_MODE_READ_WRITE},
+      {"SQL_AUTOCOMMIT_OFF", SQL_AUTOCOMMIT_OFF},
+      {"SQL_AUTOCOMMIT_ON", SQL_AUTOCOMMIT_ON},
+      {"SQL_CONCUR_READ_ONLY", SQL_CONCUR_READ_ONLY},
+      {"SQL_CONCUR_LOCK", SQL_CONCUR_LOCK},
+      {"SQL_CONCUR_ROWVER", SQL_CONCUR_ROWVER},
+      {"SQL_CONCUR_VALUES", SQL_CONCUR_VALUES},
+      {"SQL_UNSPECIFIED", SQL_UNSPECIFIED},
+      {"SQL_INSENSITIVE", SQL_INSENSITIVE},
+      {"SQL_SENSITIVE", SQL_SENSITIVE},
+      {"SQL_CURSOR_FORWARD_ONLY", SQL_CURSOR_FORWARD_ONLY},
+      {"SQL_CURSOR_STATIC", SQL_CURSOR_STATIC},
+      {"SQL_CURSOR_KEYSET_DRIVEN", SQL_CURSOR_KEYSET_DRIVEN},
+      {"SQL_CURSOR_DYNAMIC", SQL_CURSOR_DYNAMIC},
+      {"SQL_NOSCAN_OFF", SQL_NOSCAN_OFF},
+      {"SQL_NOSCAN_ON", SQL_NOSCAN_ON},
+      {"SQL_TXN_READ_UNCOMMITTED", SQL_TXN_READ_UNCOMMITTED},
+      {"SQL_TXN_READ_COMMITTED", SQL_TXN_READ_COMMITTED},
+      {"SQL_TXN_REPEATABLE_READ", SQL_TXN_REPEATABLE_READ},
+      {"SQL_TXN_SERIALIZABLE", SQL_TXN_SERIALIZABLE},
+  };
+
+  vector<OdbcAttribute> attributes;
+  for (auto &entry : ListValue::GetChildren(map)) {
+    auto &key_value = StructValue::GetChildren(entry);
+    auto name = StringUtil::Upper(key_value[0].ToString());
+
+    OdbcAttribute attribute;
+    auto known = attribute_names.find(name);
+    if (known != attribute_names.end()) {
+      attribute.attribute = known->second;
+    } else if (IsIntegerString(name)) {
+      int64_t id;
+      if (!TryParseInteger(name, id) || id < NumericLimits<SQLINTEGER>::Minimum() ||
+          id > NumericLimits<SQLINTEGER>::Maximum()) {
+        throw BinderException("odbc_scan %s attribute \"%s\" is out of range", parameter, name);
+      }
+      attribute.attribute = (SQLINTEGER)id;
+    } else {
+      throw BinderException("odbc_scan %s has an unknown attribute \"%s\"", parameter, name);
+    }
+
+    attribute.string_value = key_value[1].IsNull() ? "" : key_value[1].ToString();
+    attribute.integer_value = 0;
+    auto value_name = value_names.find(StringUtil::Upper(attribute.string_value));
+    if (string_attributes.find(attribute.attribute) != string_attributes.end()) {
+      attribute.is_string = true;
+    } else if (value_name != value_names.end()) {
+      attribute.is_string = false;
+      attribute.integer_value = value_name->second;
+    } else if (IsIntegerString(attribute.string_value)) {
+      int64_t value;
+      if (!TryParseInteger(attribute.string_value, value)) {
+        throw BinderException("odbc_scan %s value \"%s\" of attribute \"%s\" is out of range", parameter,
+                              attribute.string_value, name);
+      }
+      attribute.is_string = false;
+      attribute.integer_value = (SQLULEN)value;
+    } else if (known != attribute_names.end()) {
+      throw BinderException("odbc_scan %s attribute \"%s\" requires an integer or SQL_ constant value, not "
+                            "\"%s\"",
+                            parameter, name, attribute.string_value);
+    } else {
+      attribute.is_string = true;
+    }
+    attributes.push_back(attribute);
+  }
+
+  return attributes;
+}
+
+// Prepares the scan's statement on every shard. The first shard's result shape is used when its columns
+// match the other shards by name, DuckDB type and C type.
+// Dials a shard, or checks an idle connection out of its pool, and prepares and describes its statement
+static void OdbcScanBindShard(OdbcScanShard &shard, OdbcConnectionPool &pool, const string &sql_statement,
+                              const vector<OdbcAttribute> &statement_attributes,
+                              vector<OdbcColumnDescription> &columns) {
+  shard.lease = pool.Acquire();
+  shard.connection = shard.lease->connection;
+
+  // the pool's dialect is set before its first connection is leased and isn't changed afterwards
+  shard.statement_opts = pool.dialect->StatementOptions();
+  shard.statement_opts->attributes = statement_attributes;
+  shard.statement = shard.lease->statement_cache->Acquire(sql_statement, *shard.statement_opts);
+  columns = shard.statement->DescribeColumns();
+}
+
+static void OdbcScanBindShards(ClientContext &context, OdbcScanBindData &bind_data,
+                               const vector<Value> &connection_strings,
+                               const vector<OdbcAttribute> &connection_attributes,
+                               const vector<OdbcAttribute> &statement_attributes) {
+  auto shard_count = connection_strings.size();
+  vector<shared_ptr<OdbcConnectionPool>> pools;
+  for (idx_t i = 0; i < shard_count; i++) {
+    auto shard = make_uniq<OdbcScanShard>();
+    shard->connection_string = connection_strings[i].GetValue<string>();
+    pools.push_back(OdbcConnectionPool::Get(context, shard->connection_string, connection_attributes));
+    bind_data.shards.push_back(std::move(shard));
+  }
+
+  // shards are dialed and described concurrently so binding waits for the slowest shard rather than all of
+  // them in turn
+  vector<vector<OdbcColumnDescription>> shard_columns(shard_count);
+  vector<std::exception_ptr> errors(shard_count);
+  vector<std::thread> threads;
+  for (idx_t i = 0; i < shard_count; i++) {
+    threads.emplace_back([&, i]() {
+      try {
+        OdbcScanBindShard(*bind_data.shards[i], *pools[i], bind_data.sql_statement, statement_attributes,
+                          shard_columns[i]);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (auto &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  // filters and samples are pushed down with the first shard's dialect
+  bind_data.dialect = pools[0]->dialect;
+  for (idx_t i = 0; i < shard_count; i++) {
+    auto &shard = bind_data.shards[i];
+    auto &columns = shard_columns[i];
+    pools[i]->dialect->BindColumnTypes(columns);
+    if (i == 0) {
+      for (auto &column : columns) {
+        bind_data.column_descriptions.push_back(column);
+        bind_data.names.push_back(string((char *)column.name));
+        // shards may quote identifiers differently
+        bind_data.remote_names.push_back(bind_data.names.back());
+        bind_data.types.push_back(OdbcColumnToDuckDBLogicalType(column));
+      }
+      bind_data.statement_opts = make_uniq<OdbcStatementOptions>(shard->statement_opts->row_array_size);
+    } else {
+      if (columns.size() != bind_data.column_descriptions.size()) {
+        throw BinderException("odbc_scan shard %d returns %d columns but shard 0 returns %d", i,
+                              columns.size(), bind_data.column_descriptions.size());
+      }
+      for (idx_t c = 0; c < columns.size(); c++) {
+        auto name = string((char *)columns[c].name);
+        if (!StringUtil::CIEquals(name, bind_data.names[c]) ||
+            OdbcColumnToDuckDBLogicalType(columns[c]) != bind_data.types[c] ||
+            columns[c].c_data_type != bind_data.column_descriptions[c].c_data_type) {
+          throw BinderException("odbc_scan column \"%s\" of shard %d isn't compatible with column \"%s\" of "
+                                "shard 0",
+                                name, i, bind_data.names[c]);
+        }
+        // every shard is fetched into the same buffers so they hold the widest value of any shard
+        bind_data.column_descriptions[c].length =
+            MaxValue(bind_data.column_descriptions[c].length, columns[c].length);
+      }
+      bind_data.statement_opts->row_array_size =
+          MaxValue(bind_data.statement_opts->row_array_size, shard->statement_opts->row_array_size);
+    }
   }
 }
 
 static unique_ptr<FunctionData> OdbcScanBind(ClientContext &context, TableFunctionBindInput &input,
                                              vector<LogicalType> &return_types, vector<string> &names) {
   auto bind_data = make_uniq<OdbcScanBindData>();
-  bind_data->connection_string = input.inputs[0].GetValue<string>();
+  auto sharded = input.inputs[0].type().id() == LogicalTypeId::LIST;
+  vector<OdbcAttribute> connection_attributes;
+  vector<OdbcAttribute> statement_attributes;
   bind_data->schema_name = input.inputs[1].GetValue<string>();
   bind_data->table_name = input.inputs[2].GetValue<string>();
 
-  bind_data->environment = make_shared<OdbcEnvironment>();
-  bind_data->environment->Init();
+  for (auto &kv : input.named_parameters) {
+    if (kv.first == "cache") {
+      bind_data->cache = BooleanValue::Get(kv.second);
+    } else if (kv.first == "shard_id") {
+      bind_data->shard_id_column = BooleanValue::Get(kv.second);
+    } else if (kv.first == "connection_attributes") {
+      connection_attributes = OdbcScanParseAttributes(kv.first, kv.second);
+    } else if (kv.first == "statement_attributes") {
+      statement_attributes = OdbcScanParseAttributes(kv.first, kv.second);
+    }
+  }
 
-  bind_data->connection = make_shared<OdbcConnection>();
-  bind_data->connection->Init(bind_data->environment);
-  bind_data->connection->Dial(bind_data->connection_string);
+  bind_data->sql_statement = "SELECT * FROM " + bind_data->TableReference();
 
-  bind_data->statement = make_uniq<OdbcStatement>(bind_data->connection);
-  bind_data->statement->Init();
+  if (sharded) {
+    auto &connection_strings = ListValue::GetChildren(input.inputs[0]);
+    if (connection_strings.empty()) {
+      throw BinderException("odbc_scan requires at least one connection string");
+    }
+    if (bind_data->cache) {
+      throw BinderException("odbc_scan can't cache the result of a scan across shards");
+    }
+    bind_data->connection_string = connection_strings[0].GetValue<string>();
+    OdbcScanBindShards(context, *bind_data, connection_strings, connection_attributes, statement_attributes);
+
+    if (bind_data->shard_id_column) {
+      bind_data->names.push_back("shard_id");
+      bind_data->types.push_back(LogicalType::INTEGER);
+    }
+    names = bind_data->names;
+    return_types = bind_data->types;
 
-  string sql_statement = "SELECT * FROM ";
-  if (bind_data->schema_name.compare(string(""))) {
-    sql_statement += bind_data->schema_name + ".";
+    return std::move(bind_data);
   }
-  sql_statement += bind_data->table_name;
-  bind_data->statement->Prepare(sql_statement);
+  if (bind_data->shard_id_column) {
+    throw BinderException("odbc_scan shard_id requires a list of connection strings");
+  }
+  bind_data->connection_string = input.inputs[0].GetValue<string>();
+
+  // repeated scans of a connection string check out an idle connection and its prepared statement
+  bind_data->pool = OdbcConnectionPool::Get(context, bind_data->connection_string, connection_attributes);
+  bind_data->statement_attributes = statement_attributes;
+
+  if (bind_data->cache) {
+    bind_data->cache_key = OdbcResultCache::Key(bind_data->connection_string, bind_data->sql_statement,
+                                                connection_attributes, statement_attributes);
+    bind_data->cache_max_size = OdbcResultCache::MaxSizeInBytes(context);
+    bind_data->cached_result =
+        OdbcResultCache::Get(context)->Lookup(bind_data->cache_key, OdbcResultCache::TtlSeconds(context));
+    if (bind_data->cached_result) {
+      // served without connecting to the remote database
+      bind_data->names = bind_data->cached_result->names;
+      bind_data->types = bind_data->cached_result->types;
+      names = bind_data->names;
+      return_types = bind_data->types;
+
+      return std::move(bind_data);
+    }
+  }
+
+  bind_data->lease = bind_data->pool->Acquire();
+  bind_data->connection = bind_data->lease->connection;
+  bind_data->dialect = bind_data->pool->dialect;
+  bind_data->statement_cache = bind_data->lease->statement_cache;
+  bind_data->statement_opts = bind_data->dialect->StatementOptions();
+  bind_data->statement_opts->attributes = statement_attributes;
+  bind_data->statement =
+      bind_data->statement_cache->Acquire(bind_data->sql_statement, *bind_data->statement_opts);
 
   auto columns = bind_data->statement->DescribeColumns();
+  bind_data->dialect->BindColumnTypes(columns);
   for (int i = 0; i < columns.size(); i++) {
     auto duckdb_type = OdbcColumnToDuckDBLogicalType(columns[i]);
     bind_data->column_descriptions.push_back(columns[i]);
     bind_data->names.push_back(string((char *)columns[i].name));
+    bind_data->remote_names.push_back(bind_data->dialect->QuoteIdentifier(bind_data->names.back()));
     bind_data->types.push_back(duckdb_type);
   }
 
-  // bind_data->statement_opts = make_uniq<OdbcStatementOptions>(1);
-  // bind_data->statement_opts = make_uniq<OdbcStatementOptions>(2);
-  // bind_data->statement_opts =
-  // make_uniq<OdbcStatementOptions>(STANDARD_VECTOR_SIZE * 2);
-  bind_data->statement_opts = make_uniq<OdbcStatementOptions>(STANDARD_VECTOR_SIZE);
-  bind_data->statement->Execute(bind_data->statement_opts);
-
   names = bind_data->names;
   return_types = bind_data->types;
 
   return std::move(bind_data);
 }
 
+// Prepares the statement of a scan bound to a cached result that expired before the scan was executed
+static void OdbcScanPrepareUncached(const OdbcScanBindData &bind_data, OdbcScanGlobalState &global_state) {
+  global_state.lease = bind_data.pool->Acquire();
+  auto &dialect = bind_data.pool->dialect;
+  global_state.statement_opts = dialect->StatementOptions();
+  global_state.statement_opts->attributes = bind_data.statement_attributes;
+  global_state.statement =
+      global_state.lease->statement_cache->Acquire(bind_data.sql_statement, *global_state.statement_opts);
+
+  global_state.column_descriptions = global_state.statement->DescribeColumns();
+  dialect->BindColumnTypes(global_state.column_descriptions);
+  auto &columns = global_state.column_descriptions;
+  auto changed = columns.size() != bind_data.types.size();
+  for (idx_t c = 0; !changed && c < columns.size(); c++) {
+    changed = OdbcColumnToDuckDBLogicalType(columns[c]) != bind_data.types[c];
+  }
+  if (changed) {
+    throw Exception("odbc_scan columns of " + bind_data.table_name +
+                    " changed since its cached result was bound");
+  }
+}
+
 static unique_ptr<GlobalTableFunctionState> OdbcScanInitGlobalState(ClientContext &context,
                                                                     TableFunctionInitInput &input) {
-  return make_uniq<OdbcScanGlobalState>();
+  auto &bind_data = input.bind_data->Cast<OdbcScanBindData>();
+  auto global_state = make_uniq<OdbcScanGlobalState>();
+
+  global_state->max_threads = MaxValue<idx_t>(bind_data.shards.size(), 1);
+  // a previous execution of the plan, e.g. of a prepared statement, leaves its cursor open when the scan is
+  // stopped early
+  if (bind_data.statement) {
+    bind_data.statement->Close();
+  }
+  for (auto &shard : bind_data.shards) {
+    shard->statement->Close();
+  }
+  if (bind_data.cached_result) {
+    // the TTL is checked again as a prepared statement can execute the scan long after it was bound. An
+    // expired result may have been replaced by a newer one in the meantime
+    auto ttl_seconds = OdbcResultCache::TtlSeconds(context);
+    global_state->cached_result = bind_data.cached_result;
+    if (global_state->cached_result->Expired(ttl_seconds)) {
+      global_state->cached_result = OdbcResultCache::Get(context)->Lookup(bind_data.cache_key, ttl_seconds);
+    }
+  }
+  if (global_state->cached_result) {
+    global_state->cached_result->collection->InitializeScan(global_state->cache_scan_state);
+  } else if (bind_data.cache) {
+    if (bind_data.cached_result) {
+      OdbcScanPrepareUncached(bind_data, *global_state);
+    }
+    // join filter, sample and limit pushdowns clear cache, so only scans that populate the cache are misses
+    OdbcResultCache::Get(context)->Miss();
+    global_state->cache_collection =
+        make_shared<ColumnDataCollection>(BufferManager::GetBufferManager(context), bind_data.types);
+  }
+
+  return std::move(global_state);
 }
 
 static unique_ptr<LocalTableFunctionState> OdbcScanInitLocalState(ExecutionContext &context,
                                                                   TableFunctionInitInput &input,
                                                                   GlobalTableFunctionState *global_state) {
   auto &bind_data = input.bind_data->Cast<OdbcScanBindData>();
-  auto row_array_size = bind_data.statement_opts->row_array_size;
-  auto local_state = make_uniq<OdbcScanLocalState>(row_array_size);
-
-  bind_data.statement->SetAttribute(SQL_ATTR_ROW_STATUS_PTR, (SQLPOINTER)&local_state->row_status[0]);
-
-  for (SQLSMALLINT c = 0; c < bind_data.column_descriptions.size(); c++) {
-    auto col_desc = bind_data.column_descriptions.at(c);
+  auto &scan_state = global_state->Cast<OdbcScanGlobalState>();
+  if (scan_state.cached_result) {
+    return make_uniq<OdbcScanLocalState>(0);
+  }
 
+  auto &statement_opts = scan_state.statement_opts ? scan_state.statement_opts : bind_data.statement_opts;
+  auto &column_descriptions =
+      scan_state.statement ? scan_state.column_descriptions : bind_data.column_descriptions;
+  auto row_array_size = statement_opts->row_array_size;
+  auto local_state = make_uniq<OdbcScanLocalState>(row_array_size);
+  for (auto &col_desc : column_descriptions) {
     local_state->column_bindings.emplace_back(col_desc, row_array_size);
-    auto column_binding = &local_state->column_bindings.at(c);
-    bind_data.statement->BindColumn(c + 1, column_binding->c_data_type, column_binding->buffer,
-                                    column_binding->column_buffer_length, column_binding->strlen_or_ind);
+  }
+
+  // shards are bound when a thread claims them
+  if (bind_data.shards.empty()) {
+    auto &statement = scan_state.statement ? *scan_state.statement : *bind_data.statement;
+    OdbcScanBindColumns(bind_data, statement, *local_state);
   }
 
   return std::move(local_state);
@@ -277,13 +785,28 @@ static string OdbcScanToString(const FunctionData *bind_data_p) {
   D_ASSERT(bind_data_p);
 
   auto bind_data = (const OdbcScanBindData *)bind_data_p;
-  return bind_data->table_name;
+  string result;
+  if (bind_data->joined || (bind_data->shards.empty() && bind_data->Rewritten())) {
+    result = bind_data->sql_statement;
+  } else if (!bind_data->shards.empty()) {
+    result = bind_data->table_name + " (" + std::to_string(bind_data->shards.size()) + " shards)";
+  } else {
+    result = bind_data->table_name;
+  }
+  for (auto &join_filter : bind_data->join_filters) {
+    result += "\n" + join_filter->ToString();
+  }
+  return result;
 }
 
-OdbcScanFunction::OdbcScanFunction()
-    : TableFunction("odbc_scan", {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR}, OdbcScan,
-                    OdbcScanBind, OdbcScanInitGlobalState, OdbcScanInitLocalState) {
+OdbcScanFunction::OdbcScanFunction(const LogicalType &connection_string_type)
+    : TableFunction("odbc_scan", {connection_string_type, LogicalType::VARCHAR, LogicalType::VARCHAR},
+                    OdbcScan, OdbcScanBind, OdbcScanInitGlobalState, OdbcScanInitLocalState) {
   to_string = OdbcScanToString;
+  named_parameters["cache"] = LogicalType::BOOLEAN;
+  named_parameters["shard_id"] = LogicalType::BOOLEAN;
+  named_parameters["connection_attributes"] = LogicalType::MAP(LogicalType::VARCHAR, LogicalType::VARCHAR);
+  named_parameters["statement_attributes"] = LogicalType::MAP(LogicalType::VARCHAR, LogicalType::VARCHAR);
   // projection_pushdown = true;
 }
 } // namespace duckdb
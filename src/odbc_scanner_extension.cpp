@@ -1,14 +1,21 @@
 #define DUCKDB_EXTENSION_MAIN
 
 #include "odbc_scanner_extension.hpp"
+#include "odbc_lookup.hpp"
+#include "odbc_optimizer.hpp"
+#include "odbc_result_cache.hpp"
 #include "odbc_scan.hpp"
+#include "odbc_statement_cache.hpp"
+#include "odbc_storage.hpp"
 
 #include "duckdb.hpp"
 
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/string_util.hpp"
+#include "duckdb/function/function_set.hpp"
 #include "duckdb/function/scalar_function.hpp"
 #include "duckdb/function/table_function.hpp"
+#include "duckdb/main/config.hpp"
 #include "duckdb/main/extension_util.hpp"
 
 #include "duckdb/parser/parsed_data/create_scalar_function_info.hpp"
@@ -16,16 +23,64 @@
 
 namespace duckdb {
 static void LoadInternal(DatabaseInstance &instance) {
+  // settings
+  auto &config = DBConfig::GetConfig(instance);
+  config.AddExtensionOption("odbc_result_cache_ttl_seconds",
+                            "Seconds a cached odbc_scan result can be served before it is fetched again",
+                            LogicalType::UBIGINT, Value::UBIGINT(ODBC_RESULT_CACHE_DEFAULT_TTL_SECONDS));
+  config.AddExtensionOption("odbc_result_cache_max_size",
+                            "Maximum number of bytes held by the odbc_scan result cache",
+                            LogicalType::UBIGINT,
+                            Value::UBIGINT(ODBC_RESULT_CACHE_DEFAULT_MAX_SIZE_IN_BYTES));
+  config.AddExtensionOption("odbc_statement_cache_size",
+                            "Idle prepared statements cached per ODBC connection. Read when a data source is "
+                            "first connected to",
+                            LogicalType::UBIGINT, Value::UBIGINT(ODBC_STATEMENT_CACHE_DEFAULT_SIZE));
+  config.AddExtensionOption("odbc_pushdown_samples",
+                            "Sample odbc_scan's with the data source's native sampling clause",
+                            LogicalType::BOOLEAN, Value::BOOLEAN(true));
+  config.AddExtensionOption("odbc_pushdown_limits",
+                            "Set the maximum rows of odbc_scan's below a constant limit",
+                            LogicalType::BOOLEAN, Value::BOOLEAN(true));
+  config.AddExtensionOption("odbc_pushdown_joins",
+                            "Execute joins between odbc_scan's on the same connection string remotely",
+                            LogicalType::BOOLEAN, Value::BOOLEAN(true));
+  config.AddExtensionOption("odbc_pushdown_join_filters",
+                            "Restrict odbc_scan's probing a hash join to the keys of the join's build side",
+                            LogicalType::BOOLEAN, Value::BOOLEAN(true));
+
+  // optimizer
+  OptimizerExtension odbc_optimizer;
+  odbc_optimizer.optimize_function = OdbcOptimizer::Optimize;
+  config.optimizer_extensions.push_back(std::move(odbc_optimizer));
+
+  // ATTACH '<connection string>' AS name (TYPE odbc)
+  config.storage_extensions["odbc"] = make_uniq<OdbcStorageExtension>();
+
   // table functions
   Connection con(instance);
   con.BeginTransaction();
   auto &context = *con.context;
   auto &catalog = Catalog::GetSystemCatalog(context);
 
-  OdbcScanFunction odbc_scan_fun;
-  CreateTableFunctionInfo odbc_scan_info(odbc_scan_fun);
+  TableFunctionSet odbc_scan_set("odbc_scan");
+  odbc_scan_set.AddFunction(OdbcScanFunction());
+  odbc_scan_set.AddFunction(OdbcScanFunction(LogicalType::LIST(LogicalType::VARCHAR)));
+  CreateTableFunctionInfo odbc_scan_info(std::move(odbc_scan_set));
   catalog.CreateTableFunction(context, odbc_scan_info);
 
+  OdbcLookupFunction odbc_lookup_fun;
+  CreateTableFunctionInfo odbc_lookup_info(odbc_lookup_fun);
+  catalog.CreateTableFunction(context, odbc_lookup_info);
+
+  OdbcResultCacheStatsFunction odbc_result_cache_stats_fun;
+  CreateTableFunctionInfo odbc_result_cache_stats_info(odbc_result_cache_stats_fun);
+  catalog.CreateTableFunction(context, odbc_result_cache_stats_info);
+
+  OdbcStatementCacheStatsFunction odbc_statement_cache_stats_fun;
+  CreateTableFunctionInfo odbc_statement_cache_stats_info(odbc_statement_cache_stats_fun);
+  catalog.CreateTableFunction(context, odbc_statement_cache_stats_info);
+
   con.Commit();
 }
 
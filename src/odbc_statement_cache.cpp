@@ -0,0 +1,172 @@
+#include "odbc_statement_cache.hpp"
+#include "odbc_catalog.hpp"
+#include "odbc_connection_pool.hpp"
+
+#include "duckdb.hpp"
+
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/attached_database.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/main/database_manager.hpp"
+
+namespace duckdb {
+idx_t OdbcStatementCache::Capacity(DatabaseInstance &db) {
+  auto &config = DBConfig::GetConfig(db);
+  auto entry = config.options.set_variables.find("odbc_statement_cache_size");
+  if (entry == config.options.set_variables.end() || entry->second.IsNull()) {
+    return ODBC_STATEMENT_CACHE_DEFAULT_SIZE;
+  }
+  return entry->second.GetValue<idx_t>();
+}
+
+static string OdbcStatementCacheKey(const string &sql_statement, const string &attributes) {
+  return sql_statement + '\0' + attributes;
+}
+
+unique_ptr<OdbcStatement> OdbcStatementCache::Acquire(const string &sql_statement,
+                                                      const OdbcStatementOptions &opts) {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+
+    auto it = entries.find(OdbcStatementCacheKey(sql_statement, opts.AttributesToString()));
+    if (it != entries.end()) {
+      auto statement = std::move(*it->second);
+      lru.erase(it->second);
+      entries.erase(it);
+      hits++;
+      return statement;
+    }
+    misses++;
+  }
+
+  auto statement = make_uniq<OdbcStatement>(connection);
+  statement->Init();
+  statement->Configure(opts);
+  statement->Prepare(sql_statement);
+  return statement;
+}
+
+void OdbcStatementCache::Release(unique_ptr<OdbcStatement> statement) {
+  if (!statement || !statement->prepared) {
+    return;
+  }
+  try {
+    statement->Reset();
+  } catch (std::exception &ex) {
+    // the statement can't be reused. Freeing its handle is all that's left to do
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(lock);
+
+  // a statement with the same SQL was released by a concurrent scan first. Keep the one already cached
+  auto key = OdbcStatementCacheKey(statement->sql_statement, statement->attributes);
+  if (capacity == 0 || entries.find(key) != entries.end()) {
+    return;
+  }
+
+  lru.push_front(std::move(statement));
+  entries[key] = lru.begin();
+  while (lru.size() > capacity) {
+    entries.erase(OdbcStatementCacheKey(lru.back()->sql_statement, lru.back()->attributes));
+    lru.pop_back();
+    evictions++;
+  }
+}
+
+OdbcStatementCacheStats OdbcStatementCache::Stats() {
+  std::lock_guard<std::mutex> guard(lock);
+
+  OdbcStatementCacheStats stats;
+  stats.hits = hits;
+  stats.misses = misses;
+  stats.evictions = evictions;
+  stats.entries = entries.size();
+  return stats;
+}
+
+struct OdbcStatementCacheStatsGlobalState : public GlobalTableFunctionState {
+  OdbcStatementCacheStatsGlobalState() : finished(false) {}
+
+  bool finished;
+};
+
+static unique_ptr<FunctionData> OdbcStatementCacheStatsBind(ClientContext &context,
+                                                            TableFunctionBindInput &input,
+                                                            vector<LogicalType> &return_types,
+                                                            vector<string> &names) {
+  names = {"database_name", "connection_string", "hits", "misses", "evictions", "entries"};
+  return_types = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::UBIGINT,
+                  LogicalType::UBIGINT, LogicalType::UBIGINT, LogicalType::UBIGINT};
+
+  return nullptr;
+}
+
+static unique_ptr<GlobalTableFunctionState>
+OdbcStatementCacheStatsInitGlobalState(ClientContext &context, TableFunctionInitInput &input) {
+  return make_uniq<OdbcStatementCacheStatsGlobalState>();
+}
+
+// Connection string with the values of password keys replaced
+static string RedactConnectionString(const string &connection_string) {
+  vector<string> pairs;
+  for (auto &pair : StringUtil::Split(connection_string, ';')) {
+    auto separator = pair.find('=');
+    auto key = pair.substr(0, separator);
+    StringUtil::Trim(key);
+    auto lower_key = StringUtil::Lower(key);
+    if (separator != string::npos && (lower_key == "pwd" || lower_key == "password")) {
+      pairs.push_back(key + "=***");
+    } else {
+      pairs.push_back(pair);
+    }
+  }
+  return StringUtil::Join(pairs, ";");
+}
+
+static void OdbcStatementCacheStatsRow(DataChunk &output, idx_t row, const Value &database_name,
+                                       OdbcConnectionPool &pool) {
+  auto stats = pool.Stats();
+  output.SetValue(0, row, database_name);
+  output.SetValue(1, row, Value(RedactConnectionString(pool.connection_string)));
+  output.SetValue(2, row, Value::UBIGINT(stats.hits));
+  output.SetValue(3, row, Value::UBIGINT(stats.misses));
+  output.SetValue(4, row, Value::UBIGINT(stats.evictions));
+  output.SetValue(5, row, Value::UBIGINT(stats.entries));
+}
+
+static void OdbcStatementCacheStatsScan(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+  auto &global_state = data.global_state->Cast<OdbcStatementCacheStatsGlobalState>();
+  if (global_state.finished) {
+    return;
+  }
+
+  // one row per attached ODBC data source
+  idx_t row = 0;
+  auto databases = DatabaseManager::Get(context).GetDatabases(context);
+  for (auto &database : databases) {
+    auto &catalog = database.get().GetCatalog();
+    if (catalog.GetCatalogType() != "odbc" || row >= STANDARD_VECTOR_SIZE) {
+      continue;
+    }
+    auto &pool = *catalog.Cast<OdbcCatalog>().pool;
+    OdbcStatementCacheStatsRow(output, row++, Value(database.get().GetName()), pool);
+  }
+  // and one per pool of odbc_scan and odbc_lookup, which aren't attached to a database
+  for (auto &pool : OdbcConnectionPool::GetAll(context)) {
+    if (row >= STANDARD_VECTOR_SIZE) {
+      break;
+    }
+    OdbcStatementCacheStatsRow(output, row++, Value(LogicalType::VARCHAR), *pool);
+  }
+  output.SetCardinality(row);
+
+  global_state.finished = true;
+}
+
+OdbcStatementCacheStatsFunction::OdbcStatementCacheStatsFunction()
+    : TableFunction("odbc_statement_cache_stats", {}, OdbcStatementCacheStatsScan,
+                    OdbcStatementCacheStatsBind, OdbcStatementCacheStatsInitGlobalState) {}
+} // namespace duckdb
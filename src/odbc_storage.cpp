@@ -0,0 +1,31 @@
+#include "odbc_storage.hpp"
+#include "odbc_catalog.hpp"
+#include "odbc_transaction.hpp"
+
+#include "duckdb.hpp"
+#include "duckdb/parser/parsed_data/attach_info.hpp"
+
+namespace duckdb {
+static unique_ptr<Catalog> OdbcAttach(StorageExtensionInfo *storage_info, AttachedDatabase &db,
+                                      const string &name, AttachInfo &info, AccessMode access_mode) {
+  // idle prepared statements kept per connection of the catalog
+  auto statement_cache_size = OdbcStatementCache::Capacity(db.GetDatabase());
+  for (auto &entry : info.options) {
+    if (entry.first == "statement_cache_size") {
+      statement_cache_size = entry.second.GetValue<idx_t>();
+    }
+  }
+
+  return make_uniq<OdbcCatalog>(db, info.path, statement_cache_size);
+}
+
+static unique_ptr<TransactionManager> OdbcCreateTransactionManager(StorageExtensionInfo *storage_info,
+                                                                   AttachedDatabase &db, Catalog &catalog) {
+  return make_uniq<OdbcTransactionManager>(db);
+}
+
+OdbcStorageExtension::OdbcStorageExtension() {
+  attach = OdbcAttach;
+  create_transaction_manager = OdbcCreateTransactionManager;
+}
+} // namespace duckdb
@@ -0,0 +1,29 @@
+#include "odbc_transaction.hpp"
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+OdbcTransactionManager::OdbcTransactionManager(AttachedDatabase &db) : TransactionManager(db) {}
+
+Transaction &OdbcTransactionManager::StartTransaction(ClientContext &context) {
+  auto transaction = make_uniq<OdbcTransaction>(*this, context);
+  auto &result = *transaction;
+
+  std::lock_guard<std::mutex> guard(lock);
+  transactions[result] = std::move(transaction);
+  return result;
+}
+
+string OdbcTransactionManager::CommitTransaction(ClientContext &context, Transaction &transaction) {
+  std::lock_guard<std::mutex> guard(lock);
+  transactions.erase(transaction);
+  return string();
+}
+
+void OdbcTransactionManager::RollbackTransaction(Transaction &transaction) {
+  std::lock_guard<std::mutex> guard(lock);
+  transactions.erase(transaction);
+}
+
+void OdbcTransactionManager::Checkpoint(ClientContext &context, bool force) {}
+} // namespace duckdb